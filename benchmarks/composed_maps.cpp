@@ -0,0 +1,491 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Author: Aleksander M. Pasiut
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//! @brief Abstraction penalty of map combinators
+//!
+//! @details Measures time and number of heap allocations per call of CompositeMap, DirectSum, ImageSum, PNE and PSM
+//!          built from the Henon map (value and derivative), compared with hand-written fused implementations of the
+//!          same maps. LocalMap is compared in Separate and Fused evaluation modes. If long double intervals are
+//!          available, the vector/matrix arithmetic of LUInterval (upward rounding only) is compared with LInterval
+//!          (switching rounding mode) in a separate table. Usage: capd_utils_benchmark [calls]
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <new>
+#include <string>
+
+#include <capd_utils/capd/map.hpp>
+#include <capd_utils/affine_map.hpp>
+#include <capd_utils/composite_map.hpp>
+#include <capd_utils/direct_sum.hpp>
+#include <capd_utils/identity_map.hpp>
+#include <capd_utils/image_sum.hpp>
+#include <capd_utils/local_map.hpp>
+#include <capd_utils/map_base.hpp>
+#include <capd_utils/pne_map.hpp>
+#include <capd_utils/parallel_shooting/psm.hpp>
+
+namespace
+{
+
+std::atomic<size_t> g_allocations { 0 };
+
+}
+
+void* operator new(std::size_t size)
+{
+    ++g_allocations;
+
+    if (void* ptr = std::malloc(size > 0 ? size : 1))
+    {
+        return ptr;
+    }
+
+    throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size)
+{
+    return operator new(size);
+}
+
+void operator delete(void* ptr) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete[](void* ptr) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete(void* ptr, std::size_t) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete[](void* ptr, std::size_t) noexcept
+{
+    std::free(ptr);
+}
+
+namespace
+{
+
+using namespace CapdUtils;
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//! @brief Henon map f(x, y) = (1 - a x^2 + y, b x) with hand-written derivative
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+template<typename MapT>
+class HenonMap : public MapBase<MapT>
+{
+public:
+    using ScalarType = typename MapT::ScalarType;
+    using VectorType = typename MapT::VectorType;
+    using MatrixType = typename MapT::MatrixType;
+
+    VectorType operator() (const VectorType& vec) override
+    {
+        VectorType ret(2);
+        ret[0] = ScalarType(1.0) - m_a * vec[0] * vec[0] + vec[1];
+        ret[1] = m_b * vec[0];
+        return ret;
+    }
+
+    VectorType operator() (const VectorType& vec, MatrixType& mat) override
+    {
+        mat(1, 1) = ScalarType(-2.0) * m_a * vec[0];
+        mat(1, 2) = ScalarType(1.0);
+        mat(2, 1) = m_b;
+        mat(2, 2) = ScalarType(0.0);
+        return (*this)(vec);
+    }
+
+    unsigned dimension() const noexcept override
+    {
+        return 2;
+    }
+
+    unsigned imageDimension() const noexcept override
+    {
+        return 2;
+    }
+
+private:
+    const ScalarType m_a { 1.4 };
+    const ScalarType m_b { 0.3 };
+};
+
+//! Hand-written Henon step (x, y, D) -> (f(x, y), Df(x, y) D)
+template<typename ScalarType>
+void fused_henon_step(ScalarType& x, ScalarType& y, ScalarType (&der)[2][2])
+{
+    const ScalarType a { 1.4 };
+    const ScalarType b { 0.3 };
+
+    const ScalarType dx = ScalarType(-2.0) * a * x;
+
+    for (int j = 0; j < 2; ++j)
+    {
+        const ScalarType d0 = der[0][j];
+        der[0][j] = dx * d0 + der[1][j];
+        der[1][j] = b * d0;
+    }
+
+    const ScalarType x_next = ScalarType(1.0) - a * x * x + y;
+    y = b * x;
+    x = x_next;
+}
+
+template<typename VectorType>
+VectorType get_argument(unsigned dimension)
+{
+    VectorType ret(dimension);
+    for (unsigned i = 0; i < dimension; ++i)
+    {
+        ret[i] = 0.1 * (i + 1);
+    }
+    return ret;
+}
+
+struct Measurement
+{
+    double ns_per_call;
+    double allocations_per_call;
+};
+
+volatile size_t g_sink = 0;
+
+template<typename FuncT>
+Measurement measure(FuncT&& func, size_t calls)
+{
+    for (size_t i = 0; i < calls / 10 + 1; ++i)
+    {
+        g_sink = g_sink + func().dimension();
+    }
+
+    const size_t allocations = g_allocations;
+    const auto start = std::chrono::steady_clock::now();
+
+    for (size_t i = 0; i < calls; ++i)
+    {
+        g_sink = g_sink + func().dimension();
+    }
+
+    const auto stop = std::chrono::steady_clock::now();
+
+    return Measurement
+    {
+        std::chrono::duration<double, std::nano>(stop - start).count() / calls,
+        static_cast<double>(g_allocations - allocations) / calls
+    };
+}
+
+void report(const std::string& scalar, const std::string& name, const Measurement& map, const Measurement& fused)
+{
+    std::printf("%-10s %-28s %12.1f %10.1f %12.1f %10.1f %8.2fx\n",
+        scalar.c_str(), name.c_str(),
+        map.ns_per_call, map.allocations_per_call,
+        fused.ns_per_call, fused.allocations_per_call,
+        map.ns_per_call / fused.ns_per_call);
+}
+
+template<typename MapT>
+void run_benchmarks(const std::string& scalar, size_t calls)
+{
+    using ScalarType = typename MapT::ScalarType;
+    using VectorType = typename MapT::VectorType;
+    using MatrixType = typename MapT::MatrixType;
+
+    HenonMap<MapT> henon;
+
+    {
+        CompositeMap<MapT, HenonMap<MapT>&, HenonMap<MapT>&, HenonMap<MapT>&> map(henon, henon, henon);
+
+        const VectorType vec = get_argument<VectorType>(2);
+        MatrixType mat(2, 2);
+
+        const Measurement m_map = measure([&]() { return map(vec, mat); }, calls);
+        const Measurement m_fused = measure([&]()
+        {
+            ScalarType x = vec[0];
+            ScalarType y = vec[1];
+            ScalarType der[2][2] = { { 1.0, 0.0 }, { 0.0, 1.0 } };
+
+            for (int k = 0; k < 3; ++k)
+            {
+                fused_henon_step(x, y, der);
+            }
+
+            VectorType ret(2);
+            ret[0] = x;
+            ret[1] = y;
+
+            mat(1, 1) = der[0][0]; mat(1, 2) = der[0][1];
+            mat(2, 1) = der[1][0]; mat(2, 2) = der[1][1];
+
+            return ret;
+        }, calls);
+
+        report(scalar, "CompositeMap(f, f, f)", m_map, m_fused);
+    }
+
+    {
+        IdentityMap<MapT> id(2);
+        AffineMap<MapT> affine(get_argument<VectorType>(2), MatrixType::Identity(2));
+        CompositeMap<MapT, IdentityMap<MapT>&, AffineMap<MapT>&, HenonMap<MapT>&> map(id, affine, henon);
+
+        const VectorType vec = get_argument<VectorType>(2);
+        MatrixType mat(2, 2);
+
+        const Measurement m_map = measure([&]() { return map(vec, mat); }, calls);
+        const Measurement m_fused = measure([&]()
+        {
+            ScalarType x = vec[0] + ScalarType(0.1);
+            ScalarType y = vec[1] + ScalarType(0.2);
+            ScalarType der[2][2] = { { 1.0, 0.0 }, { 0.0, 1.0 } };
+
+            fused_henon_step(x, y, der);
+
+            VectorType ret(2);
+            ret[0] = x;
+            ret[1] = y;
+
+            mat(1, 1) = der[0][0]; mat(1, 2) = der[0][1];
+            mat(2, 1) = der[1][0]; mat(2, 2) = der[1][1];
+
+            return ret;
+        }, calls);
+
+        report(scalar, "CompositeMap(id, affine, f)", m_map, m_fused);
+    }
+
+    {
+        DirectSum<MapT, HenonMap<MapT>&, HenonMap<MapT>&> map(henon, henon);
+
+        const VectorType vec = get_argument<VectorType>(4);
+        MatrixType mat(4, 4);
+
+        const Measurement m_map = measure([&]() { return map(vec, mat); }, calls);
+        const Measurement m_fused = measure([&]()
+        {
+            VectorType ret(4);
+
+            for (unsigned k = 0; k < 4; k += 2)
+            {
+                ScalarType x = vec[k];
+                ScalarType y = vec[k+1];
+                ScalarType der[2][2] = { { 1.0, 0.0 }, { 0.0, 1.0 } };
+
+                fused_henon_step(x, y, der);
+
+                ret[k] = x;
+                ret[k+1] = y;
+
+                mat(k+1, k+1) = der[0][0]; mat(k+1, k+2) = der[0][1];
+                mat(k+2, k+1) = der[1][0]; mat(k+2, k+2) = der[1][1];
+            }
+
+            return ret;
+        }, calls);
+
+        report(scalar, "DirectSum(f, f)", m_map, m_fused);
+    }
+
+    {
+        ImageSum<MapT, HenonMap<MapT>&, HenonMap<MapT>&> map(henon, henon);
+
+        const VectorType vec = get_argument<VectorType>(2);
+        MatrixType mat(4, 2);
+
+        const Measurement m_map = measure([&]() { return map(vec, mat); }, calls);
+        const Measurement m_fused = measure([&]()
+        {
+            ScalarType x = vec[0];
+            ScalarType y = vec[1];
+            ScalarType der[2][2] = { { 1.0, 0.0 }, { 0.0, 1.0 } };
+
+            fused_henon_step(x, y, der);
+
+            VectorType ret(4);
+            for (unsigned k = 0; k < 4; k += 2)
+            {
+                ret[k] = x;
+                ret[k+1] = y;
+
+                mat(k+1, 1) = der[0][0]; mat(k+1, 2) = der[0][1];
+                mat(k+2, 1) = der[1][0]; mat(k+2, 2) = der[1][1];
+            }
+
+            return ret;
+        }, calls);
+
+        report(scalar, "ImageSum(f, f)", m_map, m_fused);
+    }
+
+    {
+        PNE<MapT, HenonMap<MapT>&> map(4, IdxList<size_t>::create(2, 2), IdxList<int>::create(4, 0, 2), std::ref(henon));
+
+        const VectorType vec = get_argument<VectorType>(4);
+        MatrixType mat(4, 4);
+
+        const Measurement m_map = measure([&]() { return map(vec, mat); }, calls);
+        const Measurement m_fused = measure([&]()
+        {
+            ScalarType x = vec[2];
+            ScalarType y = vec[3];
+            ScalarType der[2][2] = { { 1.0, 0.0 }, { 0.0, 1.0 } };
+
+            fused_henon_step(x, y, der);
+
+            VectorType ret(4);
+            ret[0] = x;
+            ret[1] = y;
+
+            mat.clear();
+            mat(1, 3) = der[0][0]; mat(1, 4) = der[0][1];
+            mat(2, 3) = der[1][0]; mat(2, 4) = der[1][1];
+
+            return ret;
+        }, calls);
+
+        report(scalar, "PNE(f)", m_map, m_fused);
+    }
+
+    {
+        const size_t n = 10;
+        PSM<MapT, HenonMap<MapT>> map(n, henon);
+
+        const VectorType vec = get_argument<VectorType>(2 * (n + 1));
+        MatrixType mat(2 * n, 2 * (n + 1));
+
+        const Measurement m_map = measure([&]() { return map(vec, mat); }, calls / n + 1);
+        const Measurement m_fused = measure([&]()
+        {
+            VectorType ret(2 * n);
+            mat.clear();
+
+            for (unsigned k = 0; k < n; ++k)
+            {
+                ScalarType x = vec[2*k];
+                ScalarType y = vec[2*k+1];
+                ScalarType der[2][2] = { { 1.0, 0.0 }, { 0.0, 1.0 } };
+
+                fused_henon_step(x, y, der);
+
+                ret[2*k] = x - vec[2*k+2];
+                ret[2*k+1] = y - vec[2*k+3];
+
+                mat(2*k+1, 2*k+1) = der[0][0]; mat(2*k+1, 2*k+2) = der[0][1];
+                mat(2*k+2, 2*k+1) = der[1][0]; mat(2*k+2, 2*k+2) = der[1][1];
+                mat(2*k+1, 2*k+3) = -1.0;
+                mat(2*k+2, 2*k+4) = -1.0;
+            }
+
+            return ret;
+        }, calls / n + 1);
+
+        report(scalar, "PSM(f), n = 10", m_map, m_fused);
+    }
+
+    {
+        // the "fused" columns hold LocalMapEvaluation::Fused (single evaluation of the underlying map for intervals)
+        const LocalCoordinateSystem<MapT> source(get_argument<VectorType>(2), MatrixType::Identity(2));
+        const LocalCoordinateSystem<MapT> destination(henon(source.get_origin()), MatrixType::Identity(2));
+
+        LocalMap<MapT, HenonMap<MapT>&> separate(henon, source, destination, LocalMapEvaluation::Separate);
+        LocalMap<MapT, HenonMap<MapT>&> fused(henon, source, destination, LocalMapEvaluation::Fused);
+
+        const VectorType vec = get_argument<VectorType>(2);
+        MatrixType mat(2, 2);
+
+        const Measurement m_separate = measure([&]() { return separate(vec, mat); }, calls);
+        const Measurement m_fused = measure([&]() { return fused(vec, mat); }, calls);
+
+        report(scalar, "LocalMap(f)", m_separate, m_fused);
+    }
+}
+
+#ifdef __HAVE_LONG__
+
+template<typename VectorType, typename MatrixType>
+Measurement measure_matrix_arithmetic(unsigned dimension, size_t calls)
+{
+    const VectorType vec = get_argument<VectorType>(dimension);
+
+    MatrixType mat(dimension, dimension);
+    for (unsigned i = 1; i <= dimension; ++i)
+    {
+        for (unsigned j = 1; j <= dimension; ++j)
+        {
+            mat(i, j) = 1.0 / (i + j);
+        }
+    }
+
+    return measure([&]()
+    {
+        VectorType ret = mat * vec;
+        ret += vec;
+        ret *= ret[0];
+        return ret;
+    }, calls);
+}
+
+void report_rounding(const std::string& name, const Measurement& switching, const Measurement& upward)
+{
+    std::printf("%-28s %12.1f %10.1f %12.1f %10.1f %8.2fx\n",
+        name.c_str(),
+        switching.ns_per_call, switching.allocations_per_call,
+        upward.ns_per_call, upward.allocations_per_call,
+        switching.ns_per_call / upward.ns_per_call);
+}
+
+void run_rounding_benchmarks(size_t calls)
+{
+    const unsigned dimension = 20;
+
+    const Measurement switching = measure_matrix_arithmetic<LIVector, LIMatrix>(dimension, calls);
+    const Measurement upward = measure_matrix_arithmetic<LUIVector, LUIMatrix>(dimension, calls);
+
+    std::printf("\n%-28s %12s %10s %12s %10s %9s\n",
+        "long double arithmetic", "LI ns/call", "allocs", "LUI ns/call", "allocs", "speedup");
+
+    report_rounding("matrix * vector, n = 20", switching, upward);
+}
+
+#endif
+
+}
+
+int main(int argc, char* argv[])
+{
+    const size_t calls = argc > 1 ? std::stoul(argv[1]) : 100000;
+
+    std::printf("%-10s %-28s %12s %10s %12s %10s %9s\n",
+        "scalar", "map", "ns/call", "allocs", "fused ns", "allocs", "penalty");
+
+    run_benchmarks<RMap>("Real", calls);
+    run_benchmarks<IMap>("Interval", calls);
+
+#ifdef __HAVE_LONG__
+    run_benchmarks<LIMap>("LInterval", calls);
+    run_benchmarks<LUIMap>("LUInterval", calls);
+#endif
+
+#ifdef __HAVE_MPFR__
+    run_benchmarks<MpIMap>("MpInterval", calls / 10 + 1);
+#endif
+
+#ifdef __HAVE_LONG__
+    run_rounding_benchmarks(calls);
+#endif
+
+    return 0;
+}
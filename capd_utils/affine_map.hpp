@@ -11,6 +11,37 @@
 namespace CapdUtils
 {
 
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//! @brief Detect identity / diagonal multiplier of affine maps (entries are compared exactly)
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+template<typename MatrixType>
+JacobianStructure get_multiplier_structure(const MatrixType& multiplier)
+{
+    using ScalarType = typename MatrixType::ScalarType;
+
+    if (multiplier.numberOfRows() != multiplier.numberOfColumns())
+    {
+        return JacobianStructure::Dense;
+    }
+
+    bool is_identity = true;
+
+    for (unsigned i = 1; i <= multiplier.numberOfRows(); ++i)
+    {
+        for (unsigned j = 1; j <= multiplier.numberOfColumns(); ++j)
+        {
+            if (i != j && !(multiplier(i, j) == ScalarType(0.0)))
+            {
+                return JacobianStructure::Dense;
+            }
+        }
+
+        is_identity = is_identity && (multiplier(i, i) == ScalarType(1.0));
+    }
+
+    return is_identity ? JacobianStructure::Identity : JacobianStructure::Diagonal;
+}
+
 ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 //! @brief Affine map implementation
 //! @details Evaluate the map:
@@ -27,7 +58,7 @@ public:
     using VectorType = typename MapT::VectorType;
     using MatrixType = typename MapT::MatrixType;
 
-    AffineMap(VectorType origin, VectorType multiplier) : m_origin(origin), m_multiplier( Concat<MapT>::build_matrix_from_hvectors({ multiplier } ) )
+    AffineMap(VectorType origin, VectorType multiplier) : m_origin(origin), m_multiplier( Concat<MapT>::build_matrix_from_hvectors({ multiplier } ) ), m_structure( get_multiplier_structure(m_multiplier) )
     {
         if (origin.dimension() != multiplier.dimension())
         {
@@ -35,7 +66,7 @@ public:
         }
     }
 
-    AffineMap(VectorType origin, MatrixType multiplier) : m_origin(origin), m_multiplier(multiplier)
+    AffineMap(VectorType origin, MatrixType multiplier) : m_origin(origin), m_multiplier(multiplier), m_structure( get_multiplier_structure(m_multiplier) )
     {
         if (origin.dimension() != multiplier.dimension().second)
         {
@@ -43,7 +74,7 @@ public:
         }
     }
 
-    AffineMap(const LocalCoordinateSystem<MapT>& coeffs) : m_origin(coeffs.get_origin()), m_multiplier(coeffs.get_directions_matrix())
+    AffineMap(const LocalCoordinateSystem<MapT>& coeffs) : m_origin(coeffs.get_origin()), m_multiplier(coeffs.get_directions_matrix()), m_structure( get_multiplier_structure(m_multiplier) )
     {}
 
     VectorType operator() (const VectorType& vec, MatrixType& mat) override
@@ -51,14 +82,14 @@ public:
         this->assert_vector_size(vec, m_origin.dimension(), "AffineMap vec vector mismatch (1)!");
 
         mat = m_multiplier;
-        return m_multiplier * vec + m_origin;
+        return evaluate(vec);
     }
 
     VectorType operator() (const VectorType& vec) override
     {
         this->assert_vector_size(vec, m_origin.dimension(), "AffineMap vec vector mismatch (2)!");
 
-        return m_multiplier * vec + m_origin;
+        return evaluate(vec);
     }
 
     unsigned dimension() const noexcept override
@@ -71,9 +102,37 @@ public:
         return m_multiplier.dimension().first;
     }
 
+    JacobianStructure jacobian_structure() const noexcept override
+    {
+        return m_structure;
+    }
+
 private:
+    VectorType evaluate(const VectorType& vec) const
+    {
+        switch (m_structure)
+        {
+        case JacobianStructure::Identity:
+            return vec + m_origin;
+
+        case JacobianStructure::Diagonal:
+        {
+            VectorType ret(vec.dimension());
+            for (unsigned i = 1; i <= vec.dimension(); ++i)
+            {
+                ret(i) = m_multiplier(i, i) * vec(i) + m_origin(i);
+            }
+            return ret;
+        }
+
+        default:
+            return m_multiplier * vec + m_origin;
+        }
+    }
+
     const VectorType m_origin;
     const MatrixType m_multiplier;
+    const JacobianStructure m_structure;
 };
 
 
@@ -93,7 +152,7 @@ public:
     using VectorType = typename MapT::VectorType;
     using MatrixType = typename MapT::MatrixType;
 
-    AffineMap2(VectorType offset, VectorType multiplier) : m_offset(offset), m_multiplier( Concat<MapT>::build_matrix_from_hvectors({ multiplier } ) )
+    AffineMap2(VectorType offset, VectorType multiplier) : m_offset(offset), m_multiplier( Concat<MapT>::build_matrix_from_hvectors({ multiplier } ) ), m_structure( get_multiplier_structure(m_multiplier) )
     {
         if (offset.dimension() != multiplier.dimension())
         {
@@ -101,7 +160,7 @@ public:
         }
     }
 
-    AffineMap2(VectorType offset, MatrixType multiplier) : m_offset(offset), m_multiplier(multiplier)
+    AffineMap2(VectorType offset, MatrixType multiplier) : m_offset(offset), m_multiplier(multiplier), m_structure( get_multiplier_structure(m_multiplier) )
     {
         if (offset.dimension() != multiplier.dimension().second)
         {
@@ -114,14 +173,14 @@ public:
         this->assert_vector_size(vec, m_offset.dimension(), "AffineMap2 vec vector mismatch (1)!");
 
         mat = m_multiplier;
-        return m_multiplier * (vec - m_offset);
+        return evaluate(vec);
     }
 
     VectorType operator() (const VectorType& vec) override
     {
         this->assert_vector_size(vec, m_offset.dimension(), "AffineMap2 vec vector mismatch (2)!");
 
-        return m_multiplier * (vec - m_offset);
+        return evaluate(vec);
     }
 
     unsigned dimension() const noexcept override
@@ -134,9 +193,37 @@ public:
         return m_multiplier.dimension().first;
     }
 
+    JacobianStructure jacobian_structure() const noexcept override
+    {
+        return m_structure;
+    }
+
 private:
+    VectorType evaluate(const VectorType& vec) const
+    {
+        switch (m_structure)
+        {
+        case JacobianStructure::Identity:
+            return vec - m_offset;
+
+        case JacobianStructure::Diagonal:
+        {
+            VectorType ret(vec.dimension());
+            for (unsigned i = 1; i <= vec.dimension(); ++i)
+            {
+                ret(i) = m_multiplier(i, i) * (vec(i) - m_offset(i));
+            }
+            return ret;
+        }
+
+        default:
+            return m_multiplier * (vec - m_offset);
+        }
+    }
+
     const VectorType m_offset;
     const MatrixType m_multiplier;
+    const JacobianStructure m_structure;
 };
 
 }
@@ -4,14 +4,41 @@
 
 #pragma once
 
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
 #include "map_base.hpp"
 #include "pi.hpp"
 
 namespace CapdUtils
 {
 
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//! @brief Square of scalar (for intervals containing zero the result is nonnegative, unlike arg * arg)
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+template<typename ScalarType>
+ScalarType square(const ScalarType& arg)
+{
+    if constexpr (capd::TypeTraits<ScalarType>::isInterval)
+    {
+        return sqr(arg);
+    }
+    else
+    {
+        return arg * arg;
+    }
+}
+
 ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 //! @brief CAPD implementation of 2 argument arctan function.
+//!
+//! @details Value is in [-pi, pi), the cut is the half-line {x < 0, y = 0} (y = 0 belongs to the lower half-plane).
+//!          Derivative is computed in closed form (-y, x) / (x^2 + y^2), which is the same for all branches.
+//!
+//!          For interval arguments the value is the hull of the values at the corners of the box (the angle is monotone
+//!          along the edges of a box not containing the origin). If the box crosses the cut, the result is the hull of
+//!          both branches, i.e. [-pi, pi], so no subdivision is required from the caller.
 ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 template<typename MapT>
 class Arctan2 : public MapBase<MapT>
@@ -21,62 +48,36 @@ public:
     using VectorType = typename MapT::VectorType;
     using MatrixType = typename MapT::MatrixType;
 
-    Arctan2()
-        : m_map_1(func_1, 2, 1, 1)//"par: pi; var: x, y; fun: atan(y / x);")
-        , m_map_2A(func_2A, 2, 1, 1)//"par: pi; var: x, y; fun: atan(y / x) + pi;")
-        , m_map_2B(func_2B, 2, 1, 1)//"par: pi; var: x, y; fun: atan(y / x) - pi;")
-        , m_map_3(func_3, 2, 1, 1)//"par: pi; var: x, y; fun:  pi/2 - atan(x / y);")
-        , m_map_4(func_4, 2, 1, 1)//"par: pi; var: x, y; fun: -pi/2 - atan(x / y);")
+    VectorType operator() (const VectorType& vec) override
     {
-        m_map_1.setParameter(0, get_pi<ScalarType>());
-        m_map_2A.setParameter(0, get_pi<ScalarType>());
-        m_map_2B.setParameter(0, get_pi<ScalarType>());
-        m_map_3.setParameter(0, get_pi<ScalarType>());
-        m_map_4.setParameter(0, get_pi<ScalarType>());
+        this->assert_vector_size(vec, 2, "Arctan2 vec vector size mismatch (1)!");
+
+        VectorType ret(1);
+        ret[0] = evaluate(vec[0], vec[1]);
+        return ret;
     }
 
     VectorType operator() (const VectorType& vec, MatrixType& mat) override
     {
-        this->assert_vector_size(vec, 2, "Arctan2 vec vector size mismatch!");
+        this->assert_vector_size(vec, 2, "Arctan2 vec vector size mismatch (2)!");
 
-        const ScalarType x = vec[0];
-        const ScalarType y = vec[1];
+        const ScalarType& x = vec[0];
+        const ScalarType& y = vec[1];
 
-        if ( capd::abs(x) > capd::abs(y) )
-        {
-            if ( x > 0 )
-            {
-                return m_map_1(vec, mat);
-            }
-            else
-            {
-                if (y > 0)
-                {
-                    return m_map_2A(vec, mat);
-                }
-                else
-                {
-                    return m_map_2B(vec, mat);
-                }
-            }
-        }
-        else
+        VectorType ret(1);
+        ret[0] = evaluate(x, y);
+
+        const ScalarType r2 = square(x) + square(y);
+
+        if (mat.dimension() != std::make_pair(this->imageDimension(), this->dimension()))
         {
-            if ( y > 0 )
-            {
-                return m_map_3(vec, mat);
-            }
-            else
-            {
-                return m_map_4(vec, mat);
-            }
+            mat = MatrixType(1, 2);
         }
-    }
 
-    VectorType operator() (const VectorType& vec) override
-    {
-        MatrixType dummy(1, 2);
-        return (*this)(vec, dummy);
+        mat(1, 1) = -y / r2;
+        mat(1, 2) = x / r2;
+
+        return ret;
     }
 
     unsigned dimension() const noexcept override
@@ -89,62 +90,89 @@ public:
         return 1;
     }
 
-private:
-    static void func_1(Node, Node in[], int, Node out[], int, Node param[], int)
-    {
-        Node& pi = param[0];
-
-        Node& x = in[0];
-        Node& y = in[1];
-
-        out[0] = atan(y / x);
-    }
-
-    static void func_2A(Node, Node in[], int, Node out[], int, Node param[], int)
+    ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    //! @brief Value of arctan2 for (x, y) (enclosure of the range for interval arguments)
+    ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    static ScalarType evaluate(const ScalarType& x, const ScalarType& y)
     {
-        Node& pi = param[0];
-
-        Node& x = in[0];
-        Node& y = in[1];
+        if constexpr (capd::TypeTraits<ScalarType>::isInterval)
+        {
+            const bool x_contains_zero = x.leftBound() <= 0 && x.rightBound() >= 0;
+            const bool y_contains_zero = y.leftBound() <= 0 && y.rightBound() >= 0;
 
-        out[0] = atan(y / x) + pi;
-    }
+            if (x_contains_zero && y_contains_zero)
+            {
+                throw std::logic_error("Arctan2: argument contains origin!");
+            }
 
-    static void func_2B(Node, Node in[], int, Node out[], int, Node param[], int)
-    {
-        Node& pi = param[0];
+            if (x.leftBound() < 0 && y.leftBound() <= 0 && y.rightBound() > 0)
+            {
+                const ScalarType pi = get_pi<ScalarType>();
+                return ScalarType(-pi.rightBound(), pi.rightBound());
+            }
 
-        Node& x = in[0];
-        Node& y = in[1];
+            const ScalarType corners[4] =
+            {
+                evaluate_point( ScalarType(x.leftBound()), ScalarType(y.leftBound()) ),
+                evaluate_point( ScalarType(x.leftBound()), ScalarType(y.rightBound()) ),
+                evaluate_point( ScalarType(x.rightBound()), ScalarType(y.leftBound()) ),
+                evaluate_point( ScalarType(x.rightBound()), ScalarType(y.rightBound()) )
+            };
 
-        out[0] = atan(y / x) - pi;
-    }
+            auto left = corners[0].leftBound();
+            auto right = corners[0].rightBound();
 
-    static void func_3(Node, Node in[], int, Node out[], int, Node param[], int)
-    {
-        Node& pi = param[0];
-
-        Node& x = in[0];
-        Node& y = in[1];
+            for (const ScalarType& corner : corners)
+            {
+                left = std::min(left, corner.leftBound());
+                right = std::max(right, corner.rightBound());
+            }
 
-        out[0] = pi/2 - atan(x / y);
+            return ScalarType(left, right);
+        }
+        else
+        {
+            return evaluate_point(x, y);
+        }
     }
 
-    static void func_4(Node, Node in[], int, Node out[], int, Node param[], int)
+private:
+    static ScalarType evaluate_point(const ScalarType& x, const ScalarType& y)
     {
-        Node& pi = param[0];
+        using std::atan;
 
-        Node& x = in[0];
-        Node& y = in[1];
+        const ScalarType pi = get_pi<ScalarType>();
 
-        out[0] = -pi/2 - atan(x / y);
+        if ( capd::abs(x) > capd::abs(y) )
+        {
+            if ( x > 0 )
+            {
+                return atan(y / x);
+            }
+            else
+            {
+                if (y > 0)
+                {
+                    return atan(y / x) + pi;
+                }
+                else
+                {
+                    return atan(y / x) - pi;
+                }
+            }
+        }
+        else
+        {
+            if ( y > 0 )
+            {
+                return pi/2 - atan(x / y);
+            }
+            else
+            {
+                return -pi/2 - atan(x / y);
+            }
+        }
     }
-
-    MapT m_map_1;
-    MapT m_map_2A;
-    MapT m_map_2B;
-    MapT m_map_3;
-    MapT m_map_4;
 };
 
 }
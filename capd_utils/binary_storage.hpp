@@ -0,0 +1,510 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Author: Aleksander M. Pasiut
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <istream>
+#include <limits>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+
+#include "capd/basic_types.hpp"
+#include "readable_mpreal.hpp"
+
+namespace CapdUtils
+{
+
+namespace BinaryStorageInternal
+{
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//! @brief Source of bytes backed by contiguous memory (e.g. memory-mapped file)
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+class MemorySource
+{
+public:
+    MemorySource(const void* data, std::size_t size)
+        : m_ptr(static_cast<const char*>(data))
+        , m_end(static_cast<const char*>(data) + size)
+    {}
+
+    void read(void* dst, std::size_t len)
+    {
+        if (static_cast<std::size_t>(m_end - m_ptr) >= len)
+        {
+            std::memcpy(dst, m_ptr, len);
+            m_ptr += len;
+        }
+        else
+        {
+            throw std::runtime_error("BinaryStorage: unexpected end of data!");
+        }
+    }
+
+private:
+    const char* m_ptr;
+    const char* m_end;
+};
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//! @brief Source of bytes backed by input stream
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+class StreamSource
+{
+public:
+    StreamSource(std::istream& istr) : m_istr(istr)
+    {}
+
+    void read(void* dst, std::size_t len)
+    {
+        if (!m_istr.read(static_cast<char*>(dst), len))
+        {
+            throw std::runtime_error("BinaryStorage: unexpected end of stream!");
+        }
+    }
+
+private:
+    std::istream& m_istr;
+};
+
+//! Number of bytes of the object representation of T holding its value (x87 extended precision long double occupies
+//! 10 bytes of 12 or 16 bytes object, the remaining bytes are padding with indeterminate content)
+template<typename T>
+constexpr std::size_t significant_size()
+{
+    const bool is_x87_extended = std::is_same<T, long double>::value
+        && std::numeric_limits<long double>::digits == 64 && std::numeric_limits<long double>::radix == 2;
+
+    return is_x87_extended ? 10 : sizeof(T);
+}
+
+//! Append object representation of `value`, padding bytes are written as zeros
+template<typename T>
+inline void append(std::string& buffer, const T& value)
+{
+    std::array<char, sizeof(T)> bytes {};
+    std::memcpy(bytes.data(), &value, significant_size<T>());
+    buffer.append(bytes.data(), bytes.size());
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//! @brief Binary codec of trivially copyable bound type
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+template<typename BoundType>
+struct PlainBoundCodec
+{
+    static constexpr std::uint32_t size = sizeof(BoundType);
+
+    static void write(std::string& buffer, const BoundType& arg)
+    {
+        append(buffer, arg);
+    }
+
+    template<typename SourceT>
+    static BoundType read(SourceT& source)
+    {
+        BoundType ret {};
+        source.read(&ret, sizeof(BoundType));
+        return ret;
+    }
+};
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//! @brief Binary codec of interval built from codec of its bounds
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+template<typename ScalarType, typename BoundCodecT>
+struct IntervalCodec
+{
+    static constexpr std::uint32_t size = 2 * BoundCodecT::size;
+
+    static void write(std::string& buffer, const ScalarType& arg)
+    {
+        BoundCodecT::write(buffer, arg.leftBound());
+        BoundCodecT::write(buffer, arg.rightBound());
+    }
+
+    template<typename SourceT>
+    static ScalarType read(SourceT& source)
+    {
+        const auto left = BoundCodecT::read(source);
+        const auto right = BoundCodecT::read(source);
+        return ScalarType(left, right);
+    }
+};
+
+#ifdef __HAVE_MPFR__
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//! @brief Binary codec of multiprecision real
+//! @details Stores precision, sign, exponent and limbs. The record size depends on the precision.
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+struct MpRealCodec
+{
+    static constexpr std::uint32_t size = 0;
+
+    static void write(std::string& buffer, const MpReal& arg)
+    {
+        MpRealOpen open(arg);
+        const mpfr_t & mpfr_rep = open.get_rep();
+
+        append(buffer, static_cast<std::int64_t>(mpfr_rep->_mpfr_prec));
+        append(buffer, static_cast<std::int32_t>(mpfr_rep->_mpfr_sign));
+        append(buffer, static_cast<std::int64_t>(mpfr_rep->_mpfr_exp));
+
+        const std::size_t length = limb_count(mpfr_rep->_mpfr_prec);
+        buffer.append(reinterpret_cast<const char*>(mpfr_rep->_mpfr_d), sizeof(mp_limb_t) * length);
+    }
+
+    template<typename SourceT>
+    static MpReal read(SourceT& source)
+    {
+        const std::int64_t precision = PlainBoundCodec<std::int64_t>::read(source);
+        const std::int32_t sign = PlainBoundCodec<std::int32_t>::read(source);
+        const std::int64_t exponent = PlainBoundCodec<std::int64_t>::read(source);
+
+        if (precision < MPFR_PREC_MIN || precision > MPFR_PREC_MAX)
+        {
+            throw std::runtime_error("BinaryStorage: invalid multiprecision real precision!");
+        }
+
+        MpRealOpen ret(0, precision);
+        mpfr_t & mpfr_rep = ret.get_rep();
+
+        mpfr_rep->_mpfr_sign = sign;
+        mpfr_rep->_mpfr_exp = exponent;
+
+        const std::size_t length = limb_count(mpfr_rep->_mpfr_prec);
+        source.read(mpfr_rep->_mpfr_d, sizeof(mp_limb_t) * length);
+
+        return ret;
+    }
+
+private:
+    static std::size_t limb_count(MpReal::PrecisionType prec)
+    {
+        const std::size_t bits_per_limb = 8 * sizeof(mp_limb_t);
+        return prec / bits_per_limb + (prec % bits_per_limb != 0);
+    }
+};
+
+#endif
+
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//! @brief Binary codec of scalar types
+//!
+//! Each specialization provides scalar kind identifier stored in the file header, fixed record size (0 for variable
+//! size records) and write/read functions.
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+template<typename ScalarType>
+struct BinaryScalarCodec
+{
+    template<typename T>
+    struct always_false
+    {
+        static constexpr bool value = false;
+    };
+
+    static_assert(always_false<ScalarType>::value, "Unsupported scalar type!");
+};
+
+template<>
+struct BinaryScalarCodec<Real> : BinaryStorageInternal::PlainBoundCodec<Real>
+{
+    static constexpr std::uint32_t kind = 1;
+};
+
+template<>
+struct BinaryScalarCodec<Interval> : BinaryStorageInternal::IntervalCodec<Interval, BinaryStorageInternal::PlainBoundCodec<Real>>
+{
+    static constexpr std::uint32_t kind = 2;
+};
+
+#ifdef __HAVE_LONG__
+
+template<>
+struct BinaryScalarCodec<LReal> : BinaryStorageInternal::PlainBoundCodec<LReal>
+{
+    static constexpr std::uint32_t kind = 3;
+};
+
+template<>
+struct BinaryScalarCodec<LInterval> : BinaryStorageInternal::IntervalCodec<LInterval, BinaryStorageInternal::PlainBoundCodec<LReal>>
+{
+    static constexpr std::uint32_t kind = 4;
+};
+
+template<>
+struct BinaryScalarCodec<LUInterval> : BinaryStorageInternal::IntervalCodec<LUInterval, BinaryStorageInternal::PlainBoundCodec<LReal>>
+{
+    static constexpr std::uint32_t kind = 5;
+};
+
+#endif
+
+#ifdef __HAVE_MPFR__
+
+template<>
+struct BinaryScalarCodec<MpReal> : BinaryStorageInternal::MpRealCodec
+{
+    static constexpr std::uint32_t kind = 6;
+};
+
+template<>
+struct BinaryScalarCodec<MpInterval> : BinaryStorageInternal::IntervalCodec<MpInterval, BinaryStorageInternal::MpRealCodec>
+{
+    static constexpr std::uint32_t kind = 7;
+};
+
+#endif
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//! @brief Binary storage of vectors and matrices
+//!
+//! @details Data layout (native endianness):
+//!
+//!     offset  0: magic "CAPDUBIN" (8 bytes)
+//!     offset  8: format version (uint32)
+//!     offset 12: scalar kind (uint32, see BinaryScalarCodec)
+//!     offset 16: record size in bytes (uint32, 0 for variable size records, e.g. multiprecision)
+//!     offset 20: shape (uint32, 0 for vector, 1 for matrix)
+//!     offset 24: number of rows (uint64, vector dimension for vectors)
+//!     offset 32: number of columns (uint64, 1 for vectors)
+//!     offset 40: reserved (24 bytes)
+//!     offset 64: records in row-major order
+//!
+//!          Records of fixed size types start at 64-byte aligned offset, so the data may be memory-mapped and parsed
+//!          in place with parse_vector / parse_matrix. Human readable export is still available with ReadableMemory
+//!          and ReadableMpReal hex utilities.
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+template<typename MapT>
+class BinaryStorage
+{
+public:
+    using ScalarType = typename MapT::ScalarType;
+    using VectorType = typename MapT::VectorType;
+    using MatrixType = typename MapT::MatrixType;
+
+    using Codec = BinaryScalarCodec<ScalarType>;
+
+    static constexpr std::uint32_t version = 1;
+    static constexpr std::size_t header_size = 64;
+
+    static void write_vector(std::ostream& ostr, const VectorType& arg)
+    {
+        std::string buffer = create_header(shape_vector, arg.dimension(), 1);
+        reserve_records(buffer, arg.dimension());
+
+        for (unsigned i = 0; i < arg.dimension(); ++i)
+        {
+            Codec::write(buffer, arg[i]);
+        }
+
+        ostr.write(buffer.data(), buffer.size());
+    }
+
+    static void write_matrix(std::ostream& ostr, const MatrixType& arg)
+    {
+        std::string buffer = create_header(shape_matrix, arg.numberOfRows(), arg.numberOfColumns());
+        reserve_records(buffer, arg.numberOfRows() * arg.numberOfColumns());
+
+        for (unsigned i = 1; i <= arg.numberOfRows(); ++i)
+        {
+            for (unsigned j = 1; j <= arg.numberOfColumns(); ++j)
+            {
+                Codec::write(buffer, arg(i,j));
+            }
+        }
+
+        ostr.write(buffer.data(), buffer.size());
+    }
+
+    static VectorType read_vector(std::istream& istr)
+    {
+        BinaryStorageInternal::StreamSource source(istr);
+        const Header header = read_header(source);
+        check_vector_header(header);
+
+        if constexpr (Codec::size > 0)
+        {
+            std::string records(header.rows * Codec::size, '\0');
+            source.read(records.data(), records.size());
+
+            BinaryStorageInternal::MemorySource records_source(records.data(), records.size());
+            return read_vector_records(records_source, header);
+        }
+        else
+        {
+            return read_vector_records(source, header);
+        }
+    }
+
+    static MatrixType read_matrix(std::istream& istr)
+    {
+        BinaryStorageInternal::StreamSource source(istr);
+        const Header header = read_header(source);
+        check_matrix_header(header);
+
+        if constexpr (Codec::size > 0)
+        {
+            std::string records(header.rows * header.cols * Codec::size, '\0');
+            source.read(records.data(), records.size());
+
+            BinaryStorageInternal::MemorySource records_source(records.data(), records.size());
+            return read_matrix_records(records_source, header);
+        }
+        else
+        {
+            return read_matrix_records(source, header);
+        }
+    }
+
+    ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    //! @brief Parse vector from contiguous memory block (e.g. memory-mapped file)
+    ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    static VectorType parse_vector(const void* data, std::size_t size)
+    {
+        BinaryStorageInternal::MemorySource source(data, size);
+        const Header header = read_header(source);
+        check_vector_header(header);
+        return read_vector_records(source, header);
+    }
+
+    ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    //! @brief Parse matrix from contiguous memory block (e.g. memory-mapped file)
+    ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    static MatrixType parse_matrix(const void* data, std::size_t size)
+    {
+        BinaryStorageInternal::MemorySource source(data, size);
+        const Header header = read_header(source);
+        check_matrix_header(header);
+        return read_matrix_records(source, header);
+    }
+
+private:
+    static constexpr std::uint32_t shape_vector = 0;
+    static constexpr std::uint32_t shape_matrix = 1;
+
+    static constexpr std::array<char, 8> magic = { 'C', 'A', 'P', 'D', 'U', 'B', 'I', 'N' };
+
+    struct Header
+    {
+        std::uint32_t shape;
+        std::uint64_t rows;
+        std::uint64_t cols;
+    };
+
+    static std::string create_header(std::uint32_t shape, std::uint64_t rows, std::uint64_t cols)
+    {
+        using BinaryStorageInternal::append;
+
+        std::string ret {};
+        ret.append(magic.data(), magic.size());
+        append(ret, version);
+        append(ret, Codec::kind);
+        append(ret, Codec::size);
+        append(ret, shape);
+        append(ret, rows);
+        append(ret, cols);
+        ret.resize(header_size, '\0');
+        return ret;
+    }
+
+    static void reserve_records(std::string& buffer, std::size_t count)
+    {
+        if (Codec::size > 0)
+        {
+            buffer.reserve(header_size + count * Codec::size);
+        }
+    }
+
+    template<typename SourceT>
+    static Header read_header(SourceT& source)
+    {
+        std::array<char, header_size> raw {};
+        source.read(raw.data(), raw.size());
+
+        if (std::memcmp(raw.data(), magic.data(), magic.size()) != 0)
+        {
+            throw std::runtime_error("BinaryStorage: invalid magic!");
+        }
+
+        BinaryStorageInternal::MemorySource fields(raw.data() + magic.size(), raw.size() - magic.size());
+
+        std::uint32_t file_version {};
+        std::uint32_t file_kind {};
+        std::uint32_t file_size {};
+        Header ret {};
+
+        fields.read(&file_version, sizeof(file_version));
+        fields.read(&file_kind, sizeof(file_kind));
+        fields.read(&file_size, sizeof(file_size));
+        fields.read(&ret.shape, sizeof(ret.shape));
+        fields.read(&ret.rows, sizeof(ret.rows));
+        fields.read(&ret.cols, sizeof(ret.cols));
+
+        if (file_version != version)
+        {
+            throw std::runtime_error("BinaryStorage: unsupported format version!");
+        }
+
+        if (file_kind != Codec::kind || file_size != Codec::size)
+        {
+            throw std::runtime_error("BinaryStorage: scalar type mismatch!");
+        }
+
+        return ret;
+    }
+
+    static void check_vector_header(const Header& header)
+    {
+        if (header.shape != shape_vector || header.cols != 1)
+        {
+            throw std::runtime_error("BinaryStorage: vector expected!");
+        }
+    }
+
+    static void check_matrix_header(const Header& header)
+    {
+        if (header.shape != shape_matrix)
+        {
+            throw std::runtime_error("BinaryStorage: matrix expected!");
+        }
+    }
+
+    template<typename SourceT>
+    static VectorType read_vector_records(SourceT& source, const Header& header)
+    {
+        VectorType ret(header.rows);
+        for (unsigned i = 0; i < ret.dimension(); ++i)
+        {
+            ret[i] = Codec::read(source);
+        }
+
+        return ret;
+    }
+
+    template<typename SourceT>
+    static MatrixType read_matrix_records(SourceT& source, const Header& header)
+    {
+        MatrixType ret(header.rows, header.cols);
+        for (unsigned i = 1; i <= ret.numberOfRows(); ++i)
+        {
+            for (unsigned j = 1; j <= ret.numberOfColumns(); ++j)
+            {
+                ret(i,j) = Codec::read(source);
+            }
+        }
+
+        return ret;
+    }
+};
+
+}
@@ -0,0 +1,379 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Author: Aleksander M. Pasiut
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <algorithm>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "capd/basic_tools.hpp"
+
+namespace CapdUtils
+{
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//! @brief Block sparse matrix
+//!
+//! @details Matrix is the sum of dense blocks placed at arbitrary (row, column) offsets. Blocks are kept sorted by row
+//!          and column offsets (block-CSR with variable block sizes), so the memory is proportional to the number of
+//!          stored entries, e.g. O(n N^2) for Jacobians of parallel shooting maps with n segments of dimension N.
+//!
+//!          Indices of offsets are 0-based, entries of blocks are accessed as in CAPD matrices (1-based).
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+template<typename MapT>
+class BlockSparseMatrix
+{
+public:
+    using ScalarType = typename MapT::ScalarType;
+    using VectorType = typename MapT::VectorType;
+    using MatrixType = typename MapT::MatrixType;
+
+    struct Block
+    {
+        unsigned row_offset;
+        unsigned col_offset;
+        MatrixType value;
+    };
+
+    BlockSparseMatrix() : m_rows(0), m_cols(0)
+    {}
+
+    BlockSparseMatrix(unsigned rows, unsigned cols) : m_rows(rows), m_cols(cols)
+    {}
+
+    ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    //! @brief Block of size (rows, cols) at given offsets (zero block is inserted if it is not present)
+    ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    MatrixType& block(unsigned row_offset, unsigned col_offset, unsigned rows, unsigned cols)
+    {
+        if (row_offset + rows > m_rows || col_offset + cols > m_cols)
+        {
+            throw std::logic_error("BlockSparseMatrix: block is out of range!");
+        }
+
+        auto it = std::lower_bound(m_blocks.begin(), m_blocks.end(), std::make_pair(row_offset, col_offset),
+            [](const Block& b, const std::pair<unsigned, unsigned>& pos)
+            {
+                return std::make_pair(b.row_offset, b.col_offset) < pos;
+            });
+
+        if (it != m_blocks.end() && it->row_offset == row_offset && it->col_offset == col_offset)
+        {
+            if (it->value.dimension() != std::make_pair(rows, cols))
+            {
+                throw std::logic_error("BlockSparseMatrix: block size mismatch!");
+            }
+
+            return it->value;
+        }
+
+        return m_blocks.insert(it, Block{ row_offset, col_offset, MatrixType(rows, cols) })->value;
+    }
+
+    const std::vector<Block>& blocks() const noexcept
+    {
+        return m_blocks;
+    }
+
+    ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    //! @brief Fill all blocks with zeros (blocks are kept, so repeated evaluations do not allocate)
+    ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    void clear()
+    {
+        for (Block& b : m_blocks)
+        {
+            b.value.clear();
+        }
+    }
+
+    unsigned numberOfRows() const noexcept
+    {
+        return m_rows;
+    }
+
+    unsigned numberOfColumns() const noexcept
+    {
+        return m_cols;
+    }
+
+    std::pair<unsigned, unsigned> dimension() const noexcept
+    {
+        return std::make_pair(m_rows, m_cols);
+    }
+
+    ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    //! @brief Number of stored entries
+    ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    size_t entries() const noexcept
+    {
+        size_t ret = 0;
+        for (const Block& b : m_blocks)
+        {
+            ret += b.value.numberOfRows() * b.value.numberOfColumns();
+        }
+        return ret;
+    }
+
+    VectorType operator* (const VectorType& vec) const
+    {
+        if (vec.dimension() != m_cols)
+        {
+            throw std::logic_error("BlockSparseMatrix: vector size mismatch!");
+        }
+
+        VectorType ret(m_rows);
+
+        for (const Block& b : m_blocks)
+        {
+            for (unsigned i = 1; i <= b.value.numberOfRows(); ++i)
+            {
+                for (unsigned j = 1; j <= b.value.numberOfColumns(); ++j)
+                {
+                    ret(b.row_offset + i) += b.value(i, j) * vec(b.col_offset + j);
+                }
+            }
+        }
+
+        return ret;
+    }
+
+    ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    //! @brief Dense product C * this, where structural zeros of this matrix are skipped
+    ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    MatrixType left_multiply(const MatrixType& C) const
+    {
+        if (C.numberOfColumns() != m_rows)
+        {
+            throw std::logic_error("BlockSparseMatrix: matrix size mismatch!");
+        }
+
+        MatrixType ret(C.numberOfRows(), m_cols);
+
+        for (const Block& b : m_blocks)
+        {
+            for (unsigned r = 1; r <= C.numberOfRows(); ++r)
+            {
+                for (unsigned k = 1; k <= b.value.numberOfRows(); ++k)
+                {
+                    const ScalarType& c = C(r, b.row_offset + k);
+
+                    for (unsigned j = 1; j <= b.value.numberOfColumns(); ++j)
+                    {
+                        ret(r, b.col_offset + j) += c * b.value(k, j);
+                    }
+                }
+            }
+        }
+
+        return ret;
+    }
+
+    ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    //! @brief Replace value of each block B by func(B) (positions and sizes of blocks are kept)
+    ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    template<typename FuncT>
+    void transform(FuncT func)
+    {
+        for (Block& b : m_blocks)
+        {
+            b.value = func(b.value);
+        }
+    }
+
+    ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    //! @brief Solve this * x = rhs by Gaussian elimination with partial pivoting on sparse rows
+    //!
+    //! @details Only stored entries and the fill-in are processed, e.g. the block bidiagonal Jacobians of parallel
+    //!          shooting maps with cyclic or boundary condition rows are solved in O(n N^3) instead of O((n N)^3)
+    //!          operations. Pivots are chosen by magnitude of midpoints, so the method is intended for point matrices
+    //!          (e.g. Newton steps), not for rigorous interval solutions.
+    ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    VectorType solve(const VectorType& rhs) const
+    {
+        if (m_rows != m_cols || rhs.dimension() != m_rows)
+        {
+            throw std::logic_error("BlockSparseMatrix: solve requires square matrix and matching right-hand side!");
+        }
+
+        const unsigned n = m_rows;
+
+        std::vector<SparseRow> rows = get_rows();
+        VectorType b = rhs;
+
+        std::vector<bool> eliminated(n, false);
+        std::vector<unsigned> pivot_rows(n);
+
+        for (unsigned k = 0; k < n; ++k)
+        {
+            // rows which are not eliminated yet start at column k or later
+            unsigned pivot = n;
+            ScalarType pivot_magnitude(0.0);
+
+            for (unsigned r = 0; r < n; ++r)
+            {
+                if (!eliminated[r] && !rows[r].empty() && rows[r].front().first == k)
+                {
+                    const ScalarType magnitude = middle( capd::abs(rows[r].front().second) );
+
+                    if (pivot == n || magnitude > pivot_magnitude)
+                    {
+                        pivot = r;
+                        pivot_magnitude = magnitude;
+                    }
+                }
+            }
+
+            if (pivot == n || !(pivot_magnitude > 0.0))
+            {
+                throw std::runtime_error("BlockSparseMatrix: singular matrix!");
+            }
+
+            eliminated[pivot] = true;
+            pivot_rows[k] = pivot;
+
+            for (unsigned r = 0; r < n; ++r)
+            {
+                if (!eliminated[r] && !rows[r].empty() && rows[r].front().first == k)
+                {
+                    const ScalarType factor = rows[r].front().second / rows[pivot].front().second;
+
+                    rows[r] = subtract_rows(rows[r], rows[pivot], factor);
+                    b[r] -= factor * b[pivot];
+                }
+            }
+        }
+
+        VectorType ret(n);
+
+        for (unsigned k = n; k-- > 0;)
+        {
+            const SparseRow& row = rows[pivot_rows[k]];
+            ScalarType value = b[pivot_rows[k]];
+
+            for (size_t e = 1; e < row.size(); ++e)
+            {
+                value -= row[e].second * ret[row[e].first];
+            }
+
+            ret[k] = value / row.front().second;
+        }
+
+        return ret;
+    }
+
+    MatrixType to_dense() const
+    {
+        MatrixType ret(m_rows, m_cols);
+
+        for (const Block& b : m_blocks)
+        {
+            for (unsigned i = 1; i <= b.value.numberOfRows(); ++i)
+            {
+                for (unsigned j = 1; j <= b.value.numberOfColumns(); ++j)
+                {
+                    ret(b.row_offset + i, b.col_offset + j) += b.value(i, j);
+                }
+            }
+        }
+
+        return ret;
+    }
+
+private:
+    //! Entries (column, value) of single row sorted by columns (0-based)
+    using SparseRow = std::vector<std::pair<unsigned, ScalarType>>;
+
+    std::vector<SparseRow> get_rows() const
+    {
+        std::vector<SparseRow> entries(m_rows);
+
+        for (const Block& b : m_blocks)
+        {
+            for (unsigned i = 1; i <= b.value.numberOfRows(); ++i)
+            {
+                for (unsigned j = 1; j <= b.value.numberOfColumns(); ++j)
+                {
+                    entries[b.row_offset + i - 1].emplace_back(b.col_offset + j - 1, b.value(i, j));
+                }
+            }
+        }
+
+        // blocks may overlap, so the entries of the same column are summed
+        std::vector<SparseRow> ret(m_rows);
+
+        for (unsigned r = 0; r < m_rows; ++r)
+        {
+            std::stable_sort(entries[r].begin(), entries[r].end(),
+                [](const auto& lhs, const auto& rhs) { return lhs.first < rhs.first; });
+
+            for (const auto& entry : entries[r])
+            {
+                if (!ret[r].empty() && ret[r].back().first == entry.first)
+                {
+                    ret[r].back().second += entry.second;
+                }
+                else
+                {
+                    ret[r].push_back(entry);
+                }
+            }
+        }
+
+        return ret;
+    }
+
+    //! lhs - factor * rhs, where the leading entries (of the same column) cancel
+    static SparseRow subtract_rows(const SparseRow& lhs, const SparseRow& rhs, const ScalarType& factor)
+    {
+        SparseRow ret {};
+        ret.reserve(lhs.size() + rhs.size());
+
+        size_t i = 1;
+        size_t j = 1;
+
+        while (i < lhs.size() || j < rhs.size())
+        {
+            if (j == rhs.size() || (i < lhs.size() && lhs[i].first < rhs[j].first))
+            {
+                ret.push_back(lhs[i++]);
+            }
+            else if (i == lhs.size() || rhs[j].first < lhs[i].first)
+            {
+                ret.emplace_back(rhs[j].first, -factor * rhs[j].second);
+                ++j;
+            }
+            else
+            {
+                ret.emplace_back(lhs[i].first, lhs[i].second - factor * rhs[j].second);
+                ++i;
+                ++j;
+            }
+        }
+
+        return ret;
+    }
+
+    unsigned m_rows;
+    unsigned m_cols;
+
+    std::vector<Block> m_blocks;
+};
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//! @brief Check if MapU provides sparse derivative, i.e. SparseMatrixType and operator()(vec, SparseMatrixType&)
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+template<typename MapU, typename = void>
+struct HasSparseJacobian : std::false_type
+{};
+
+template<typename MapU>
+struct HasSparseJacobian<MapU, decltype(void( std::declval<MapU&>()(
+    std::declval<const typename MapU::VectorType&>(),
+    std::declval<typename MapU::SparseMatrixType&>() ) ))> : std::true_type
+{};
+
+}
@@ -4,21 +4,51 @@
 
 #pragma once
 
+#include <algorithm>
+#include <type_traits>
+#include <vector>
+
 #include <capd_utils/capd/basic_tools.hpp>
+#include <capd_utils/execution_policy.hpp>
 #include <capd_utils/map_base.hpp>
 
 namespace CapdUtils
 {
 
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//! @brief Form of the enclosure used by C1_Map
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+enum class C1_MapForm
+{
+    //! f(x0) + Df(X)(X-x0)
+    MeanValue,
+
+    //! f(x0) + S(X-x0), where j-th column of S is j-th column of Df(X_1, ..., X_j, x0_{j+1}, ..., x0_n) (Hansen).
+    //! S is a slope enclosure contained in Df(X), so the result is never wider than MeanValue, at the cost of n
+    //! evaluations of the derivative.
+    Nested
+};
+
 ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 //! @brief C1 Map implementation
 //! @details Improve computation accuracy by application of the equation:
 //!
 //!    f(X) = f(x0) + Df(X)(X-x0)
 //!
-//!  where x0 belongs to X.
+//!  where x0 belongs to X (see C1_MapForm for the alternative nested form).
+//!
+//!  If `cache_form` is set, the matrix of the form is cached for the last argument, so repeated evaluations for the same
+//!  box cost single evaluation of f(x0). The cache is keyed with the box only, hence it must be dropped by `reset_cache`
+//!  whenever the internal map changes (e.g. its parameters); otherwise stale derivative is used and the result is not
+//!  an enclosure of f(X). Therefore the cache is disabled by default.
+//!
+//!  Batches of boxes (e.g. GridMap sub-boxes) are split into `workers` chunks evaluated according to PolicyT, each with
+//!  its own map made for the batch (so changes of the internal map are always visible). By default the map is a copy of
+//!  the internal map, so it must be deep (as for CAPD maps): copies sharing state with the internal map are not
+//!  thread-safe. If MapU cannot be copied (e.g. reference to MapBase), batches are evaluated sequentially unless a map
+//!  factory is given (see `evaluate_batch`).
 ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
-template<typename MapT, typename MapU>
+template<typename MapT, typename MapU, typename PolicyT = SequentialExecution>
 class C1_Map : public MapBase<MapT>
 {
 public:
@@ -26,22 +56,108 @@ public:
     using VectorType = typename MapT::VectorType;
     using MatrixType = typename MapT::MatrixType;
 
-    C1_Map(MapU map) : m_map(map)
+    using MapBare = typename std::remove_reference<MapU>::type;
+
+    C1_Map(
+        MapU map,
+        C1_MapForm form = C1_MapForm::MeanValue,
+        PolicyT policy = PolicyT(),
+        unsigned workers = 1,
+        bool cache_form = false)
+            : m_map(map)
+            , m_form(form)
+            , m_policy(policy)
+            , m_workers( std::max(1u, workers) )
+            , m_cache_form(cache_form)
     {}
 
     VectorType operator() (const VectorType& vec) override
     {
-        MatrixType dummy {};
-        return (*this)(vec, dummy);
+        this->assert_vector_size(vec, this->dimension(), "C1_Map vec vector size mismatch (1)!");
+
+        const VectorType x0 = mid_vector(vec);
+
+        if (x0 == vec)
+        {
+            return m_map(x0);
+        }
+
+        update_form(vec);
+
+        return m_map(x0) + m_cached_form * (vec - x0);
     }
 
     VectorType operator() (const VectorType& vec, MatrixType& mat) override
     {
+        this->assert_vector_size(vec, this->dimension(), "C1_Map vec vector size mismatch (2)!");
+
+        update_form(vec);
+
+        mat = m_cached_der;
+
         const VectorType x0 = mid_vector(vec);
-        const VectorType f_x0 = m_map(x0);
+        return m_map(x0) + m_cached_form * (vec - x0);
+    }
 
-        m_map(vec, mat);
-        return f_x0 + mat * (vec - x0);
+    ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    //! @brief Evaluate the map for each of `boxes` (see GridMap)
+    //!
+    //! Chunks are evaluated by copies of the internal map if MapU is copyable, otherwise sequentially.
+    ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    std::vector<VectorType> evaluate_batch(const std::vector<VectorType>& boxes)
+    {
+        if constexpr (std::is_copy_constructible<MapBare>::value && !std::is_abstract<MapBare>::value)
+        {
+            return evaluate_batch(boxes, [this]() { return MapBare(m_map); });
+        }
+        else
+        {
+            return evaluate_sequential(boxes);
+        }
+    }
+
+    ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    //! @brief Evaluate the map for each of `boxes`
+    //!
+    //! Maps are usually not thread-safe, so each chunk is evaluated by its own map returned (by value) from `make_map()`.
+    //! The returned map must be equal to the internal map and must not share state with it or other returned maps.
+    ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    template<typename MapFactoryT>
+    std::vector<VectorType> evaluate_batch(const std::vector<VectorType>& boxes, MapFactoryT make_map)
+    {
+        const size_t chunks = std::min<size_t>(m_workers, boxes.size());
+        if (chunks <= 1)
+        {
+            return evaluate_sequential(boxes);
+        }
+
+        std::vector<VectorType> ret(boxes.size());
+
+        m_policy.run(chunks, [&](size_t k)
+        {
+            auto map = make_map();
+            MatrixType form {};
+            MatrixType der {};
+
+            for (size_t i = k; i < boxes.size(); i += chunks)
+            {
+                this->assert_vector_size(boxes[i], this->dimension(), "C1_Map vec vector size mismatch (3)!");
+
+                const VectorType x0 = mid_vector(boxes[i]);
+                compute_form(map, m_form, boxes[i], form, der);
+                ret[i] = map(x0) + form * (boxes[i] - x0);
+            }
+        });
+
+        return ret;
+    }
+
+    ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    //! @brief Drop the cached matrix of the form (required after each modification of the internal map if `cache_form` is set)
+    ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    void reset_cache() noexcept
+    {
+        m_has_cache = false;
     }
 
     unsigned dimension() const override
@@ -55,7 +171,68 @@ public:
     }
 
 private:
+    std::vector<VectorType> evaluate_sequential(const std::vector<VectorType>& boxes)
+    {
+        std::vector<VectorType> ret(boxes.size());
+        for (size_t i = 0; i < boxes.size(); ++i)
+        {
+            ret[i] = (*this)(boxes[i]);
+        }
+
+        return ret;
+    }
+
+    void update_form(const VectorType& vec)
+    {
+        if (!(m_cache_form && m_has_cache && m_cached_vec == vec))
+        {
+            compute_form(m_map, m_form, vec, m_cached_form, m_cached_der);
+            m_cached_vec = vec;
+            m_has_cache = true;
+        }
+    }
+
+    ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    //! @brief Compute matrix of the form (`form`) and derivative Df(vec) (`der`)
+    ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    template<typename MapV>
+    static void compute_form(MapV& map, C1_MapForm form_type, const VectorType& vec, MatrixType& form, MatrixType& der)
+    {
+        der = MatrixType(map.imageDimension(), map.dimension());
+
+        if (form_type == C1_MapForm::MeanValue)
+        {
+            map(vec, der);
+            form = der;
+        }
+        else
+        {
+            form = MatrixType(map.imageDimension(), map.dimension());
+
+            VectorType arg = mid_vector(vec);
+            for (unsigned j = 1; j <= vec.dimension(); ++j)
+            {
+                arg(j) = vec(j);
+                map(arg, der);
+
+                for (unsigned i = 1; i <= der.numberOfRows(); ++i)
+                {
+                    form(i, j) = der(i, j);
+                }
+            }
+        }
+    }
+
     MapU m_map;
+    const C1_MapForm m_form;
+    PolicyT m_policy;
+    const unsigned m_workers;
+    const bool m_cache_form;
+
+    bool m_has_cache = false;
+    VectorType m_cached_vec {};
+    MatrixType m_cached_form {};
+    MatrixType m_cached_der {};
 };
 
 }
@@ -9,6 +9,7 @@
 #ifdef __HAVE_LONG__
 
 #include "fenv_rounding.hpp"
+#include "fenv_upward_interval.hpp"
 
 #endif
 
@@ -41,6 +42,11 @@ using LIVector = capd::vectalg::Vector<LInterval, 0>;
 using LRMatrix = capd::vectalg::Matrix<LReal, 0, 0>;
 using LIMatrix = capd::vectalg::Matrix<LInterval, 0, 0>;
 
+using LUInterval = capd::intervals::Interval<LReal, capd::rounding::FenvUpwardRounding>;
+
+using LUIVector = capd::vectalg::Vector<LUInterval, 0>;
+using LUIMatrix = capd::vectalg::Matrix<LUInterval, 0, 0>;
+
 #endif
 
 #ifdef __HAVE_MPFR__
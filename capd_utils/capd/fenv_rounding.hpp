@@ -8,6 +8,8 @@
 
 #include <capd/rounding/DoubleRounding.h>
 
+#include <stdexcept>
+
 #include <fenv.h>
 #pragma STDC FENV_ACCESS ON
 
@@ -92,6 +94,147 @@ struct FenvRounding
     }
 };
 
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//! Implementation of capd::rounding::FenvCheckedRounding class which is equivalent of capd::rounding::FenvRounding class,
+//! but which skips redundant fesetround calls.
+//!
+//! The current rounding mode is read with fegetround and the mode is set only if it differs from the requested one.
+//! No mode is cached, the actual floating point environment is checked on every switch, so the policy stays correct
+//! if the mode is changed by other means (fesetround, other rounding policies, e.g. the one used by double precision
+//! intervals).
+//!
+//! Contract for evaluating long double interval maps from a thread pool:
+//!  - the rounding mode is a per-thread state, every interval operation sets the mode it requires, so no setup of
+//!    worker threads is required; FenvRoundingGuard may be used to restore the original mode of the thread,
+//!  - map objects (CAPD maps, solvers and wrappers) are not shared between tasks, since they keep mutable state,
+//!  - intervals computed in one thread may be freely passed to other threads.
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+struct FenvCheckedRounding
+{
+    static void roundNearest()
+    {
+        set_mode(FE_TONEAREST);
+    }
+
+    static void roundUp()
+    {
+        set_mode(FE_UPWARD);
+    }
+
+    static void roundDown()
+    {
+        set_mode(FE_DOWNWARD);
+    }
+
+    static void roundCut()
+    {
+        set_mode(FE_TOWARDZERO);
+    }
+
+    static RoundingMode test()
+    {
+        return FenvRounding::test();
+    }
+
+    static bool isWorking()
+    {
+        roundUp();
+        if (test() != RoundingMode::RoundUp)
+        {
+            return false;
+        }
+
+        roundDown();
+        if (test() != RoundingMode::RoundDown)
+        {
+            return false;
+        }
+
+        roundNearest();
+        if (test() != RoundingMode::RoundNearest)
+        {
+            return false;
+        }
+
+        roundCut();
+        if (test() != RoundingMode::RoundCut)
+        {
+            return false;
+        }
+
+        roundUp();
+        if (test() != RoundingMode::RoundUp)
+        {
+            return false;
+        }
+
+        return true;
+    }
+
+private:
+    static void set_mode(int mode)
+    {
+        if (fegetround() != mode)
+        {
+            fesetround(mode);
+        }
+    }
+};
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//! Rounding policy of long double intervals evaluated in upward rounding mode only.
+//!
+//! The policy behaves as capd::rounding::FenvCheckedRounding. It is a distinct type so that basic interval arithmetic
+//! of capd::intervals::Interval<long double, FenvUpwardRounding> can be overloaded (see fenv_upward_interval.hpp) to
+//! compute lower bounds as negated upward rounded results, e.g. down(a + b) == -up(-a - b). Operations which are not
+//! overloaded fall back to generic CAPD implementation and remain correct.
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+struct FenvUpwardRounding : public FenvCheckedRounding
+{};
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//! RAII guard of the rounding mode of the calling thread
+//!
+//! Store the rounding mode at construction (and optionally switch to the requested one) and restore it at destruction.
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+class FenvRoundingGuard
+{
+public:
+    FenvRoundingGuard() : m_saved_mode(fegetround())
+    {}
+
+    explicit FenvRoundingGuard(RoundingMode mode) : m_saved_mode(fegetround())
+    {
+        if (fesetround(to_fenv_mode(mode)) != 0)
+        {
+            throw std::runtime_error("FenvRoundingGuard: failed to set rounding mode!");
+        }
+    }
+
+    FenvRoundingGuard(const FenvRoundingGuard&) = delete;
+    FenvRoundingGuard& operator= (const FenvRoundingGuard&) = delete;
+
+    ~FenvRoundingGuard() noexcept
+    {
+        fesetround(m_saved_mode);
+    }
+
+private:
+    static int to_fenv_mode(RoundingMode mode)
+    {
+        switch (mode)
+        {
+            case RoundingMode::RoundNearest: return FE_TONEAREST;
+            case RoundingMode::RoundUp: return FE_UPWARD;
+            case RoundingMode::RoundDown: return FE_DOWNWARD;
+            case RoundingMode::RoundCut: return FE_TOWARDZERO;
+            default: throw std::invalid_argument("FenvRoundingGuard: unknown rounding mode!");
+        }
+    }
+
+    const int m_saved_mode;
+};
+
 }
 }
 
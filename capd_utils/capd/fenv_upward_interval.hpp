@@ -0,0 +1,187 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Author: Aleksander M. Pasiut
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#ifdef __HAVE_LONG__
+
+#include <stdexcept>
+#include <algorithm>
+
+#include <capd/intervals/Interval.h>
+
+#include "fenv_rounding.hpp"
+
+namespace capd
+{
+namespace intervals
+{
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//! Basic arithmetic of long double intervals with capd::rounding::FenvUpwardRounding policy.
+//!
+//! All bounds are computed in upward rounding mode. Lower bounds are obtained with the identity down(x) == -up(-x), so
+//! the rounding mode is switched at most once per thread (and only if other code changed it in the meantime). The
+//! functions are non-template overloads, hence they are preferred over generic CAPD operators for exact argument types.
+//! Compound assignment operators (used by CAPD vector and matrix arithmetic) are explicit specializations of the members
+//! of capd::intervals::Interval.
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+namespace FenvUpward
+{
+
+using RoundingPolicy = capd::rounding::FenvUpwardRounding;
+using IntervalType = Interval<long double, RoundingPolicy>;
+
+inline long double max4(long double a, long double b, long double c, long double d)
+{
+    return std::max(std::max(a, b), std::max(c, d));
+}
+
+inline IntervalType add(long double al, long double ar, long double bl, long double br)
+{
+    RoundingPolicy::roundUp();
+    return IntervalType( -((-al) - bl), ar + br );
+}
+
+inline IntervalType sub(long double al, long double ar, long double bl, long double br)
+{
+    RoundingPolicy::roundUp();
+    return IntervalType( -(br - al), ar - bl );
+}
+
+inline IntervalType mul(long double al, long double ar, long double bl, long double br)
+{
+    RoundingPolicy::roundUp();
+
+    const long double left = -max4( (-al) * bl, (-al) * br, (-ar) * bl, (-ar) * br );
+    const long double right = max4( al * bl, al * br, ar * bl, ar * br );
+    return IntervalType(left, right);
+}
+
+inline IntervalType div(long double al, long double ar, long double bl, long double br)
+{
+    if (bl <= 0.0L && br >= 0.0L)
+    {
+        throw std::domain_error("FenvUpward: division by interval containing zero!");
+    }
+
+    RoundingPolicy::roundUp();
+
+    const long double left = -max4( (-al) / bl, (-al) / br, (-ar) / bl, (-ar) / br );
+    const long double right = max4( al / bl, al / br, ar / bl, ar / br );
+    return IntervalType(left, right);
+}
+
+inline IntervalType sqr(long double al, long double ar)
+{
+    RoundingPolicy::roundUp();
+
+    if (al >= 0.0L)
+    {
+        return IntervalType( -((-al) * al), ar * ar );
+    }
+
+    if (ar <= 0.0L)
+    {
+        return IntervalType( -((-ar) * ar), al * al );
+    }
+
+    return IntervalType( 0.0L, std::max(al * al, ar * ar) );
+}
+
+}
+
+inline FenvUpward::IntervalType operator+ (const FenvUpward::IntervalType& a, const FenvUpward::IntervalType& b)
+{
+    return FenvUpward::add(a.leftBound(), a.rightBound(), b.leftBound(), b.rightBound());
+}
+
+inline FenvUpward::IntervalType operator+ (const FenvUpward::IntervalType& a, const long double& b)
+{
+    return FenvUpward::add(a.leftBound(), a.rightBound(), b, b);
+}
+
+inline FenvUpward::IntervalType operator+ (const long double& a, const FenvUpward::IntervalType& b)
+{
+    return FenvUpward::add(a, a, b.leftBound(), b.rightBound());
+}
+
+inline FenvUpward::IntervalType operator- (const FenvUpward::IntervalType& a, const FenvUpward::IntervalType& b)
+{
+    return FenvUpward::sub(a.leftBound(), a.rightBound(), b.leftBound(), b.rightBound());
+}
+
+inline FenvUpward::IntervalType operator- (const FenvUpward::IntervalType& a, const long double& b)
+{
+    return FenvUpward::sub(a.leftBound(), a.rightBound(), b, b);
+}
+
+inline FenvUpward::IntervalType operator- (const long double& a, const FenvUpward::IntervalType& b)
+{
+    return FenvUpward::sub(a, a, b.leftBound(), b.rightBound());
+}
+
+inline FenvUpward::IntervalType operator* (const FenvUpward::IntervalType& a, const FenvUpward::IntervalType& b)
+{
+    return FenvUpward::mul(a.leftBound(), a.rightBound(), b.leftBound(), b.rightBound());
+}
+
+inline FenvUpward::IntervalType operator* (const FenvUpward::IntervalType& a, const long double& b)
+{
+    return FenvUpward::mul(a.leftBound(), a.rightBound(), b, b);
+}
+
+inline FenvUpward::IntervalType operator* (const long double& a, const FenvUpward::IntervalType& b)
+{
+    return FenvUpward::mul(a, a, b.leftBound(), b.rightBound());
+}
+
+inline FenvUpward::IntervalType operator/ (const FenvUpward::IntervalType& a, const FenvUpward::IntervalType& b)
+{
+    return FenvUpward::div(a.leftBound(), a.rightBound(), b.leftBound(), b.rightBound());
+}
+
+inline FenvUpward::IntervalType operator/ (const FenvUpward::IntervalType& a, const long double& b)
+{
+    return FenvUpward::div(a.leftBound(), a.rightBound(), b, b);
+}
+
+inline FenvUpward::IntervalType operator/ (const long double& a, const FenvUpward::IntervalType& b)
+{
+    return FenvUpward::div(a, a, b.leftBound(), b.rightBound());
+}
+
+inline FenvUpward::IntervalType sqr(const FenvUpward::IntervalType& a)
+{
+    return FenvUpward::sqr(a.leftBound(), a.rightBound());
+}
+
+template<>
+inline FenvUpward::IntervalType& FenvUpward::IntervalType::operator+= (const FenvUpward::IntervalType& a)
+{
+    return *this = FenvUpward::add(leftBound(), rightBound(), a.leftBound(), a.rightBound());
+}
+
+template<>
+inline FenvUpward::IntervalType& FenvUpward::IntervalType::operator-= (const FenvUpward::IntervalType& a)
+{
+    return *this = FenvUpward::sub(leftBound(), rightBound(), a.leftBound(), a.rightBound());
+}
+
+template<>
+inline FenvUpward::IntervalType& FenvUpward::IntervalType::operator*= (const FenvUpward::IntervalType& a)
+{
+    return *this = FenvUpward::mul(leftBound(), rightBound(), a.leftBound(), a.rightBound());
+}
+
+template<>
+inline FenvUpward::IntervalType& FenvUpward::IntervalType::operator/= (const FenvUpward::IntervalType& a)
+{
+    return *this = FenvUpward::div(leftBound(), rightBound(), a.leftBound(), a.rightBound());
+}
+
+}
+}
+
+#endif
@@ -26,6 +26,7 @@ template class BasicFunction<CapdUtils::Interval>;
 
 template class BasicFunction<CapdUtils::LReal>;
 template class BasicFunction<CapdUtils::LInterval>;
+template class BasicFunction<CapdUtils::LUInterval>;
 
 #endif
 
@@ -43,6 +44,7 @@ template class Map<CapdUtils::IMatrix>;
 
 template class Map<CapdUtils::LRMatrix>;
 template class Map<CapdUtils::LIMatrix>;
+template class Map<CapdUtils::LUIMatrix>;
 
 #endif
 
@@ -65,6 +67,7 @@ template class OdeSolver<CapdUtils::IMap>;
 
 template class BasicOdeSolver<CapdUtils::LRMap>;
 template class OdeSolver<CapdUtils::LIMap>;
+template class OdeSolver<CapdUtils::LUIMap>;
 
 #endif
 
@@ -87,6 +90,7 @@ template class TimeMap<CapdUtils::OdeSolver<CapdUtils::IMap>>;
 
 template class TimeMap<CapdUtils::OdeSolver<CapdUtils::LRMap>>;
 template class TimeMap<CapdUtils::OdeSolver<CapdUtils::LIMap>>;
+template class TimeMap<CapdUtils::OdeSolver<CapdUtils::LUIMap>>;
 
 #endif
 
@@ -104,6 +108,7 @@ template class PoincareMap<CapdUtils::OdeSolver<CapdUtils::IMap>, CapdUtils::Coo
 
 template class BasicPoincareMap<CapdUtils::OdeSolver<CapdUtils::LRMap>, CapdUtils::CoordinateSection<CapdUtils::LRMap>>;
 template class PoincareMap<CapdUtils::OdeSolver<CapdUtils::LIMap>, CapdUtils::CoordinateSection<CapdUtils::LIMap>>;
+template class PoincareMap<CapdUtils::OdeSolver<CapdUtils::LUIMap>, CapdUtils::CoordinateSection<CapdUtils::LUIMap>>;
 
 #endif 
 
@@ -114,6 +119,7 @@ template class PoincareMap<CapdUtils::OdeSolver<CapdUtils::IMap>, CapdUtils::Aff
 
 template class BasicPoincareMap<CapdUtils::OdeSolver<CapdUtils::LRMap>, CapdUtils::AffineSection<CapdUtils::LRMap>>;
 template class PoincareMap<CapdUtils::OdeSolver<CapdUtils::LIMap>, CapdUtils::AffineSection<CapdUtils::LIMap>>;
+template class PoincareMap<CapdUtils::OdeSolver<CapdUtils::LUIMap>, CapdUtils::AffineSection<CapdUtils::LUIMap>>;
 
 #endif
 
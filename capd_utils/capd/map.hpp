@@ -16,6 +16,7 @@ using IMap = capd::map::Map<IMatrix>;
 
 using LRMap = capd::map::Map<LRMatrix>;
 using LIMap = capd::map::Map<LIMatrix>;
+using LUIMap = capd::map::Map<LUIMatrix>;
 
 #endif
 
@@ -40,6 +41,7 @@ extern template class BasicFunction<CapdUtils::Interval>;
 
 extern template class BasicFunction<CapdUtils::LReal>;
 extern template class BasicFunction<CapdUtils::LInterval>;
+extern template class BasicFunction<CapdUtils::LUInterval>;
 
 #endif
 
@@ -57,6 +59,7 @@ extern template class Map<CapdUtils::IMatrix>;
 
 extern template class Map<CapdUtils::LRMatrix>;
 extern template class Map<CapdUtils::LIMatrix>;
+extern template class Map<CapdUtils::LUIMatrix>;
 
 #endif
 
@@ -51,6 +51,7 @@ extern template class OdeSolver<CapdUtils::IMap>;
 
 extern template class BasicOdeSolver<CapdUtils::LRMap>;
 extern template class OdeSolver<CapdUtils::LIMap>;
+extern template class OdeSolver<CapdUtils::LUIMap>;
 
 #endif
 
@@ -53,6 +53,7 @@ extern template class PoincareMap<CapdUtils::OdeSolver<CapdUtils::IMap>, CapdUti
 
 extern template class BasicPoincareMap<CapdUtils::OdeSolver<CapdUtils::LRMap>, CapdUtils::CoordinateSection<CapdUtils::LRMap>>;
 extern template class PoincareMap<CapdUtils::OdeSolver<CapdUtils::LIMap>, CapdUtils::CoordinateSection<CapdUtils::LIMap>>;
+extern template class PoincareMap<CapdUtils::OdeSolver<CapdUtils::LUIMap>, CapdUtils::CoordinateSection<CapdUtils::LUIMap>>;
 
 #endif
 
@@ -63,6 +64,7 @@ extern template class PoincareMap<CapdUtils::OdeSolver<CapdUtils::IMap>, CapdUti
 
 extern template class BasicPoincareMap<CapdUtils::OdeSolver<CapdUtils::LRMap>, CapdUtils::AffineSection<CapdUtils::LRMap>>;
 extern template class PoincareMap<CapdUtils::OdeSolver<CapdUtils::LIMap>, CapdUtils::AffineSection<CapdUtils::LIMap>>;
+extern template class PoincareMap<CapdUtils::OdeSolver<CapdUtils::LUIMap>, CapdUtils::AffineSection<CapdUtils::LUIMap>>;
 
 #endif
 
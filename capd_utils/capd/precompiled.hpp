@@ -0,0 +1,32 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Author: Aleksander M. Pasiut
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//! Precompiled header of capd_utils.
+//!
+//! Gathers CAPD headers (capdlib.h and optionally mpcapdlib.h) together with the core capd_utils headers, so that they
+//! are parsed once per target instead of once per translation unit. Used by CMake when CAPD_UTILS_PRECOMPILED_HEADERS
+//! option is enabled. It must not be included directly by the library headers.
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "basic_types.hpp"
+#include "basic_tools.hpp"
+#include "gauss_solver.hpp"
+#include "norm.hpp"
+#include "map.hpp"
+#include "ode_solver.hpp"
+#include "section.hpp"
+#include "timemap.hpp"
+#include "poincare_map.hpp"
+#include "c0rect2set.hpp"
+#include "c1rect2set.hpp"
+
+#include "../map_base.hpp"
+#include "../map_compatibility.hpp"
+#include "../concat.hpp"
+#include "../extract.hpp"
+#include "../idx_list.hpp"
+#include "../type_cast.hpp"
@@ -27,6 +27,7 @@ extern template class TimeMap<CapdUtils::OdeSolver<CapdUtils::IMap>>;
 
 extern template class TimeMap<CapdUtils::OdeSolver<CapdUtils::LRMap>>;
 extern template class TimeMap<CapdUtils::OdeSolver<CapdUtils::LIMap>>;
+extern template class TimeMap<CapdUtils::OdeSolver<CapdUtils::LUIMap>>;
 
 #endif
 
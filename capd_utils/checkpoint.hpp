@@ -0,0 +1,251 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Author: Aleksander M. Pasiut
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+
+#include "binary_storage.hpp"
+
+namespace CapdUtils
+{
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//! @brief Writer of checkpoint payload
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+class CheckpointWriter
+{
+public:
+    CheckpointWriter(std::ostream& ostr) : m_ostr(ostr)
+    {}
+
+    void write_index(std::uint64_t arg)
+    {
+        m_ostr.write(reinterpret_cast<const char*>(&arg), sizeof(arg));
+    }
+
+    template<typename MapT>
+    void write_vector(const typename MapT::VectorType& arg)
+    {
+        BinaryStorage<MapT>::write_vector(m_ostr, arg);
+    }
+
+    template<typename MapT>
+    void write_matrix(const typename MapT::MatrixType& arg)
+    {
+        BinaryStorage<MapT>::write_matrix(m_ostr, arg);
+    }
+
+    template<typename MapT>
+    void write_scalar(const typename MapT::ScalarType& arg)
+    {
+        typename MapT::VectorType vec(1);
+        vec[0] = arg;
+        BinaryStorage<MapT>::write_vector(m_ostr, vec);
+    }
+
+private:
+    std::ostream& m_ostr;
+};
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//! @brief Reader of checkpoint payload
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+class CheckpointReader
+{
+public:
+    CheckpointReader(std::istream& istr) : m_istr(istr)
+    {}
+
+    std::uint64_t read_index()
+    {
+        std::uint64_t ret {};
+        if (!m_istr.read(reinterpret_cast<char*>(&ret), sizeof(ret)))
+        {
+            throw std::runtime_error("Checkpoint: unexpected end of file!");
+        }
+
+        return ret;
+    }
+
+    template<typename MapT>
+    typename MapT::VectorType read_vector()
+    {
+        return BinaryStorage<MapT>::read_vector(m_istr);
+    }
+
+    template<typename MapT>
+    typename MapT::MatrixType read_matrix()
+    {
+        return BinaryStorage<MapT>::read_matrix(m_istr);
+    }
+
+    template<typename MapT>
+    typename MapT::ScalarType read_scalar()
+    {
+        const typename MapT::VectorType vec = BinaryStorage<MapT>::read_vector(m_istr);
+        if (vec.dimension() != 1)
+        {
+            throw std::runtime_error("Checkpoint: scalar expected!");
+        }
+
+        return vec[0];
+    }
+
+private:
+    std::istream& m_istr;
+};
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//! @brief File based checkpoint of long running computation
+//!
+//! @details The checkpoint is identified by `tag` of the computation (e.g. "NewtonMethod") which is stored in the file
+//!          together with the payload. The file is written into temporary file first and then renamed, so the previous
+//!          checkpoint stays valid if the process is interrupted during the save.
+//!
+//!          The payload is saved by `update` every `period` calls, or unconditionally by `save`.
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+class Checkpoint
+{
+public:
+    Checkpoint(const std::string& path, std::size_t period = 1)
+        : m_path(path)
+        , m_period(check_period(period))
+        , m_counter(0)
+    {}
+
+    ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    //! @brief Save payload written by `save_function(CheckpointWriter&)` every `period` calls
+    ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    template<typename SaveFunctionT>
+    void update(const std::string& tag, SaveFunctionT save_function)
+    {
+        if (++m_counter % m_period == 0)
+        {
+            save(tag, save_function);
+        }
+    }
+
+    ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    //! @brief Save payload written by `save_function(CheckpointWriter&)`
+    ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    template<typename SaveFunctionT>
+    void save(const std::string& tag, SaveFunctionT save_function)
+    {
+        const std::string tmp_path = m_path + ".tmp";
+
+        {
+            std::ofstream ofs(tmp_path, std::ios::binary | std::ios::trunc);
+
+            ofs.write(magic.data(), magic.size());
+
+            const std::uint64_t tag_size = tag.size();
+            ofs.write(reinterpret_cast<const char*>(&tag_size), sizeof(tag_size));
+            ofs.write(tag.data(), tag.size());
+
+            CheckpointWriter writer(ofs);
+            save_function(writer);
+
+            ofs.flush();
+            if (!ofs)
+            {
+                throw std::runtime_error("Checkpoint: failed to write file `" + tmp_path + "`!");
+            }
+        }
+
+        if (std::rename(tmp_path.c_str(), m_path.c_str()) != 0)
+        {
+            throw std::runtime_error("Checkpoint: failed to rename file `" + tmp_path + "`!");
+        }
+    }
+
+    ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    //! @brief Load payload with `load_function(CheckpointReader&)`
+    //!
+    //! @return false if there is no checkpoint, it belongs to other computation, its payload cannot be read (e.g. it was
+    //!         saved with other scalar type) or `load_function` rejected it
+    ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    template<typename LoadFunctionT>
+    bool load(const std::string& tag, LoadFunctionT load_function)
+    {
+        std::ifstream ifs(m_path, std::ios::binary);
+
+        if (ifs)
+        {
+            std::array<char, 8> file_magic {};
+            std::uint64_t tag_size {};
+
+            ifs.read(file_magic.data(), file_magic.size());
+            ifs.read(reinterpret_cast<char*>(&tag_size), sizeof(tag_size));
+
+            if (!ifs || file_magic != magic || tag_size != tag.size())
+            {
+                return false;
+            }
+
+            std::string file_tag(tag_size, '\0');
+            ifs.read(file_tag.data(), file_tag.size());
+
+            if (!ifs || file_tag != tag)
+            {
+                return false;
+            }
+
+            try
+            {
+                CheckpointReader reader(ifs);
+                return load_function(reader);
+            }
+            catch (const std::runtime_error&)
+            {
+                // CheckpointReader and BinaryStorage report truncated or incompatible payload with std::runtime_error
+                return false;
+            }
+        }
+        else
+        {
+            return false;
+        }
+    }
+
+    ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    //! @brief Remove checkpoint file
+    ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    void remove()
+    {
+        std::remove(m_path.c_str());
+    }
+
+    const std::string& get_path() const noexcept
+    {
+        return m_path;
+    }
+
+private:
+    static std::size_t check_period(std::size_t period)
+    {
+        if (period > 0)
+        {
+            return period;
+        }
+        else
+        {
+            throw std::invalid_argument("Checkpoint: period must be greater than 0!");
+        }
+    }
+
+    static constexpr std::array<char, 8> magic = { 'C', 'A', 'P', 'D', 'U', 'C', 'H', 'K' };
+
+    const std::string m_path;
+    const std::size_t m_period;
+    std::size_t m_counter;
+};
+
+}
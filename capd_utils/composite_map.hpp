@@ -4,112 +4,126 @@
 
 #pragma once
 
+#include <stdexcept>
+#include <string>
+#include <tuple>
+
 #include "map_base.hpp"
 #include "map_compatibility.hpp"
+#include "map_tuple.hpp"
 
 namespace CapdUtils
 {
 
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//! @brief Composite map implementation
+//! @details F(x) = f_n( ... f_2( f_1(x) ) ... )
+//!
+//!  Maps are stored in a flat tuple and evaluated in order; the derivative is accumulated in a single matrix, where
+//!  products with identity and diagonal derivatives are skipped (see JacobianStructure).
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 template<typename MapT, typename MapU, typename... MapV>
 class CompositeMap : public MapBase<MapT>
 {
 public:
-    static_assert(MapCompatibility<MapT, MapU>::value);
+    static_assert(MapCompatibility<MapT, MapU>::value && (MapCompatibility<MapT, MapV>::value && ...));
 
     using ScalarType = typename MapT::ScalarType;
     using VectorType = typename MapT::VectorType;
     using MatrixType = typename MapT::MatrixType;
 
-    CompositeMap(MapU map_1, MapV... map_2_args) : m_map_1(map_1), m_map_2(map_2_args...)
+    CompositeMap(MapU map_1, MapV... map_2_args) : m_maps(map_1, map_2_args...)
     {
-        if (map_1.imageDimension() != m_map_2.dimension())
+        for_each_map(m_maps, [this](const auto& map, size_t i)
         {
-            throw std::logic_error("Composite map dimensions mismatch!");
-        }
+            if (i > 0 && map.dimension() != m_image_dimension)
+            {
+                throw std::logic_error("Composite map dimensions mismatch!");
+            }
+
+            if (i == 0)
+            {
+                m_dimension = map.dimension();
+            }
+
+            m_image_dimension = map.imageDimension();
+        });
     }
 
     VectorType operator() (const VectorType& vec) override
     {
-        this->assert_vector_size(vec, m_map_1.dimension(), "CompositeMap vec vector size mismatch (1)!");
-
-        const VectorType v1 = m_map_1(vec);
-        const VectorType v2 = m_map_2(v1);
-        return v2;
-    }
-
-    VectorType operator() (const VectorType& vec, MatrixType& mat) override
-    {
-        this->assert_vector_size(vec, m_map_1.dimension(), "CompositeMap vec vector size mismatch (2)!");
-
-        MatrixType m1(m_map_1.imageDimension(), m_map_1.dimension());
-        const VectorType v1 = m_map_1(vec, m1);
-        this->assert_matrix_size(m1, m_map_1.imageDimension(), m_map_1.dimension(), "CompositeMap m1 matrix size mismatch!");
+        this->assert_vector_size(vec, this->dimension(), "CompositeMap vec vector size mismatch (1)!");
 
-        MatrixType m2(m_map_2.imageDimension(), m_map_2.dimension());
-        const VectorType v2 = m_map_2(v1, m2);
-        this->assert_matrix_size(m2, m_map_2.imageDimension(), m_map_2.dimension(), "CompositeMap m2 matrix size mismatch!");
+        VectorType ret = vec;
 
-        mat = m2 * m1;
-        return v2;
-    }
+        for_each_map(m_maps, [&](auto& map, size_t)
+        {
+            ret = map(ret);
+        });
 
-    unsigned dimension() const noexcept override
-    {
-        return m_map_1.dimension();
+        return ret;
     }
 
-    unsigned imageDimension() const noexcept override
+    VectorType operator() (const VectorType& vec, MatrixType& mat) override
     {
-        return m_map_2.imageDimension();
-    }
-
-private:
-    MapU m_map_1;
-    CompositeMap<MapT, MapV...> m_map_2;
-};
+        this->assert_vector_size(vec, this->dimension(), "CompositeMap vec vector size mismatch (2)!");
 
+        VectorType ret = vec;
+        JacobianStructure structure = JacobianStructure::Identity;
 
-template<typename MapT, typename MapU>
-class CompositeMap<MapT, MapU> : public MapBase<MapT>
-{
-public:
-    static_assert(MapCompatibility<MapT, MapU>::value);
-
-    using ScalarType = typename MapT::ScalarType;
-    using VectorType = typename MapT::VectorType;
-    using MatrixType = typename MapT::MatrixType;
-
-    CompositeMap(MapU map) : m_map(map)
-    {}
+        for_each_map(m_maps, [&](auto& map, size_t i)
+        {
+            const JacobianStructure map_structure = get_jacobian_structure(map);
+
+            if (i == 0)
+            {
+                mat = MatrixType(map.imageDimension(), map.dimension());
+                ret = map(ret, mat);
+                this->assert_matrix_size(mat, map.imageDimension(), map.dimension(), "CompositeMap m1 matrix size mismatch!");
+            }
+            else
+            {
+                MatrixType der(map.imageDimension(), map.dimension());
+                ret = map(ret, der);
+                this->assert_matrix_size(der, map.imageDimension(), map.dimension(),
+                    "CompositeMap m" + std::to_string(i+1) + " matrix size mismatch!");
+
+                mat = compose_jacobians(der, map_structure, mat, structure);
+            }
+
+            structure = compose_structures(map_structure, structure);
+        });
 
-    VectorType operator() (const VectorType& vec) override
-    {
-        this->assert_vector_size(vec, m_map.dimension(), "CompositeMap vec vector size mismatch (1)!");
-        return m_map(vec);
+        return ret;
     }
 
-    VectorType operator() (const VectorType& vec, MatrixType& mat) override
+    JacobianStructure jacobian_structure() const override
     {
-        this->assert_vector_size(vec, m_map.dimension(), "CompositeMap vec vector size mismatch (2)!");
+        JacobianStructure ret = JacobianStructure::Identity;
 
-        const VectorType ret = m_map(vec, mat);
-        this->assert_matrix_size(mat, m_map.imageDimension(), m_map.dimension(), "CompositeMap mat matrix size mismatch!");
+        for_each_map(m_maps, [&](const auto& map, size_t)
+        {
+            ret = compose_structures(get_jacobian_structure(map), ret);
+        });
 
         return ret;
     }
 
     unsigned dimension() const noexcept override
     {
-        return m_map.dimension();
+        return m_dimension;
     }
 
     unsigned imageDimension() const noexcept override
     {
-        return m_map.imageDimension();
+        return m_image_dimension;
     }
 
 private:
-    MapU m_map;
+    std::tuple<MapU, MapV...> m_maps;
+
+    unsigned m_dimension {};
+    unsigned m_image_dimension {};
 };
 
 }
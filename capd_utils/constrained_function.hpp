@@ -10,8 +10,8 @@
 #include <capd_utils/extract.hpp>
 #include <capd_utils/composite_map.hpp>
 #include <capd_utils/extension_map.hpp>
-#include <capd_utils/projection_map.hpp>
 #include <capd_utils/newton_method/newton_method.hpp>
+#include <capd_utils/capd/basic_tools.hpp>
 
 namespace CapdUtils
 {
@@ -30,6 +30,10 @@ namespace CapdUtils
 //!
 //!              g : R^n \rightarrow R^k.
 //!
+//!          The constraint is solved by Newton method warm-started from the previous solution, so evaluations along
+//!          a curve converge in few steps. If the warm-started solve fails, the solve is repeated from the initial
+//!          value. The solution for the last argument is shared between value and derivative evaluations.
+//!
 ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 template<typename MapT, typename MapU, typename MapV>
 class ConstrainedFunction : public MapBase<MapT>
@@ -47,6 +51,10 @@ public:
         , m_g(g)
         , m_initial_value(initial_value)
         , m_newton_steps(newton_steps)
+        , m_extend(m_extension_idx_list)
+        , m_warm_start(initial_value)
+        , m_last_vec()
+        , m_last_arg_vector()
     {
         if (m_f.dimension() < 2)
         {
@@ -118,19 +126,29 @@ private:
     {
         this->assert_vector_size(vec, this->dimension(), "Constrained function vec vector size mismatch!");
 
-        const VectorType extension_vector { Concat<MapT>::concat_vectors({ vec, m_initial_value }) };
-        MapT extend { ExtensionMap<MapT>::create(extension_vector, m_extension_idx_list) };
+        if (m_last_vec.dimension() == vec.dimension() && m_last_vec == vec)
+        {
+            return m_last_arg_vector;
+        }
 
-        CompositeMap<MapT, MapT&, MapV&> objective
+        for (unsigned i = 0; i < vec.dimension(); ++i)
         {
-            std::ref(extend),
+            m_extend.setParameter(i, vec[i]);
+        }
+
+        CompositeMap<MapT, IndexExtensionMap<MapT>&, MapV&> objective
+        {
+            std::ref(m_extend),
             std::ref(m_g)
         };
 
-        NewtonMethod find_and_bound( objective, m_initial_value, m_newton_steps );
-        if (find_and_bound.is_successful())
+        VectorType root {};
+        if (solve(objective, m_warm_start, root) || solve(objective, m_initial_value, root))
         {
-            return Concat<MapT>::concat_vectors({ vec, find_and_bound.get_root() });
+            m_warm_start = mid_vector(root);
+            m_last_vec = vec;
+            m_last_arg_vector = Concat<MapT>::concat_vectors({ vec, root });
+            return m_last_arg_vector;
         }
         else
         {
@@ -138,6 +156,20 @@ private:
         }
     }
 
+    bool solve(CompositeMap<MapT, IndexExtensionMap<MapT>&, MapV&>& objective, const VectorType& initial_root, VectorType& root) const
+    {
+        NewtonMethod find_and_bound( objective, initial_root, m_newton_steps );
+        if (find_and_bound.is_successful())
+        {
+            root = find_and_bound.get_root();
+            return true;
+        }
+        else
+        {
+            return false;
+        }
+    }
+
     MapU m_f;
     MapV m_g;
 
@@ -148,6 +180,12 @@ private:
 
     const VectorType m_initial_value;
     size_t m_newton_steps;
+
+    IndexExtensionMap<MapT> m_extend;
+    VectorType m_warm_start;
+
+    VectorType m_last_vec;
+    VectorType m_last_arg_vector;
 };
 
 }
@@ -0,0 +1,104 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Author: Aleksander M. Pasiut
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <stdexcept>
+
+#include "map_base.hpp"
+
+namespace CapdUtils
+{
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//! @brief Pseudo-arclength system
+//!
+//! @details Implementation of map G : R^{n+1} \rightarrow R^{n+1}
+//!
+//!              G(x) = ( F(x), t * (x - b) ),
+//!
+//!          where F : R^{n+1} \rightarrow R^n is given map, t is tangent and b is base point (predicted point).
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+template<typename MapT>
+class ArclengthMap : public MapBase<MapT>
+{
+public:
+    using ScalarType = typename MapT::ScalarType;
+    using VectorType = typename MapT::VectorType;
+    using MatrixType = typename MapT::MatrixType;
+
+    ArclengthMap(MapT& map, const VectorType& tangent, const VectorType& base)
+        : m_map(map)
+        , m_tangent(tangent)
+        , m_base(base)
+    {
+        if (m_map.dimension() != m_map.imageDimension() + 1)
+        {
+            throw std::logic_error("ArclengthMap requires map from R^{n+1} to R^n!");
+        }
+
+        this->assert_vector_size(tangent, m_map.dimension(), "ArclengthMap tangent vector size mismatch!");
+        this->assert_vector_size(base, m_map.dimension(), "ArclengthMap base vector size mismatch!");
+    }
+
+    VectorType operator() (const VectorType& vec) override
+    {
+        const VectorType value = m_map(vec);
+
+        VectorType ret(m_map.dimension());
+        for (unsigned i = 0; i < value.dimension(); ++i)
+        {
+            ret[i] = value[i];
+        }
+        ret[value.dimension()] = capd::vectalg::scalarProduct(m_tangent, vec - m_base);
+
+        return ret;
+    }
+
+    VectorType operator() (const VectorType& vec, MatrixType& mat) override
+    {
+        const unsigned n = m_map.dimension();
+
+        MatrixType der(n - 1, n);
+        const VectorType value = m_map(vec, der);
+
+        mat = MatrixType(n, n);
+
+        VectorType ret(n);
+        for (unsigned i = 1; i < n; ++i)
+        {
+            for (unsigned j = 1; j <= n; ++j)
+            {
+                mat(i, j) = der(i, j);
+            }
+
+            ret(i) = value(i);
+        }
+
+        for (unsigned j = 1; j <= n; ++j)
+        {
+            mat(n, j) = m_tangent(j);
+        }
+        ret(n) = capd::vectalg::scalarProduct(m_tangent, vec - m_base);
+
+        return ret;
+    }
+
+    unsigned dimension() const noexcept override
+    {
+        return m_map.dimension();
+    }
+
+    unsigned imageDimension() const noexcept override
+    {
+        return m_map.dimension();
+    }
+
+private:
+    MapT& m_map;
+    const VectorType m_tangent;
+    const VectorType m_base;
+};
+
+}
@@ -0,0 +1,326 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Author: Aleksander M. Pasiut
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <algorithm>
+#include <list>
+#include <memory>
+#include <stdexcept>
+#include <string>
+
+#include "capd/basic_tools.hpp"
+#include "capd/norm.hpp"
+#include "continuation.arclength_map.hpp"
+#include "gauss.hpp"
+#include "krawczyk_method.expander.hpp"
+#include "type_cast.hpp"
+
+namespace CapdUtils
+{
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//! @brief Parameters of pseudo-arclength continuation
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+template<typename ScalarType>
+struct ContinuationParameters
+{
+    ScalarType initial_step = 1e-2;
+    ScalarType min_step = 1e-8;
+    ScalarType max_step = 1e-1;
+
+    //! Step is multiplied by this factor if corrector converged in at most `fast_corrector_steps` steps
+    ScalarType step_growth = 1.5;
+    size_t fast_corrector_steps = 3;
+
+    size_t max_corrector_steps = 10;
+    ScalarType tolerance = 1e-10;
+};
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//! @brief Pseudo-arclength continuation of the curve F(x) = 0, where F : R^{n+1} \rightarrow R^n
+//!
+//! @details Each step consists of:
+//!          - predictor: x + h*t, where t is unit tangent at the last point x,
+//!          - corrector: chord iterations for ArclengthMap, preconditioned by factorization of the bordered Jacobian
+//!            [ DF(x); t ] computed with the last tangent; if they fail, the Jacobian is refactorized at the predicted
+//!            point; if they fail again (or the Jacobian is singular), the step h is halved and the corrector starts
+//!            again from the factorization at x.
+//!          The step h grows if the corrector converges fast.
+//!
+//!          Points are computed in point arithmetic. Every k-th point can be validated by KrawczykMethodExpander
+//!          applied to ArclengthMap of given interval map (see `run_validated`).
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+template<typename MapT>
+class PseudoArclengthContinuation
+{
+public:
+    using ScalarType = typename MapT::ScalarType;
+    using VectorType = typename MapT::VectorType;
+    using MatrixType = typename MapT::MatrixType;
+
+    static_assert(capd::TypeTraits<ScalarType>::isInterval == false, "Continuation is implemented for point maps only!");
+
+    ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    //! @brief Constructor
+    //!
+    //! @param map               map F : R^{n+1} \rightarrow R^n
+    //! @param initial_point     approximate point of the curve (it is corrected)
+    //! @param initial_direction direction of continuation
+    //! @param parameters        continuation parameters
+    ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    PseudoArclengthContinuation(
+        MapT& map,
+        const VectorType& initial_point,
+        const VectorType& initial_direction,
+        const ContinuationParameters<ScalarType>& parameters = {})
+            : m_map(map)
+            , m_parameters(parameters)
+            , m_point(initial_point)
+            , m_tangent(initial_direction / capd::vectalg::euclNorm(initial_direction))
+            , m_step(parameters.initial_step)
+    {
+        ArclengthMap<MapT> system(m_map, m_tangent, m_point);
+
+        size_t iterations = 0;
+        if (refactorize_and_correct(system, initial_point, m_point, iterations) == false)
+        {
+            throw std::runtime_error("Continuation: failed to correct initial point!");
+        }
+
+        update_tangent();
+    }
+
+    ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    //! @brief Perform single predictor-corrector step
+    //!
+    //! @return false if the step size dropped below minimal step
+    ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    bool step()
+    {
+        while (m_step >= m_parameters.min_step)
+        {
+            const VectorType predicted = m_point + m_step * m_tangent;
+            ArclengthMap<MapT> system(m_map, m_tangent, predicted);
+
+            VectorType corrected {};
+            size_t iterations = 0;
+
+            // m_solver holds the factorization at m_point, the refactorization at the predicted point is local
+            if (correct(system, *m_solver, predicted, corrected, iterations)
+                || refactorize_and_correct(system, predicted, corrected, iterations))
+            {
+                m_point = corrected;
+                update_tangent();
+
+                if (iterations <= m_parameters.fast_corrector_steps)
+                {
+                    m_step = std::min<ScalarType>(m_step * m_parameters.step_growth, m_parameters.max_step);
+                }
+
+                return true;
+            }
+
+            m_step /= 2;
+        }
+
+        return false;
+    }
+
+    ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    //! @brief Continue curve for at most `max_points` points
+    //!
+    //! @return computed points (including the current one)
+    ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    std::list<VectorType> run(size_t max_points)
+    {
+        std::list<VectorType> ret { m_point };
+
+        while (ret.size() < max_points && step())
+        {
+            ret.push_back(m_point);
+        }
+
+        return ret;
+    }
+
+    ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    //! @brief Continue curve for at most `max_points` points and validate every `validation_period`-th point
+    //!
+    //! @return enclosures of validated points
+    ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    template<typename IMapT>
+    std::list<typename IMapT::VectorType> run_validated(
+        size_t max_points,
+        size_t validation_period,
+        IMapT& interval_map,
+        size_t krawczyk_steps)
+    {
+        if (validation_period == 0)
+        {
+            throw std::invalid_argument("Continuation: validation period must be greater than 0!");
+        }
+
+        std::list<typename IMapT::VectorType> ret {};
+
+        for (size_t i = 0; i < max_points; ++i)
+        {
+            if (i > 0 && step() == false)
+            {
+                break;
+            }
+
+            if (i % validation_period == 0)
+            {
+                typename IMapT::VectorType enclosure {};
+
+                if (validate(interval_map, krawczyk_steps, enclosure) == false)
+                {
+                    throw std::runtime_error("Continuation: validation failed at point " + std::to_string(i) + "!");
+                }
+
+                ret.push_back(enclosure);
+            }
+        }
+
+        return ret;
+    }
+
+    ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    //! @brief Rigorously enclose the point of the curve on the hyperplane orthogonal to tangent at current point
+    ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    template<typename IMapT>
+    bool validate(IMapT& interval_map, size_t krawczyk_steps, typename IMapT::VectorType& enclosure) const
+    {
+        using IVectorType = typename IMapT::VectorType;
+
+        const IVectorType point = vector_cast<IVectorType>(m_point);
+        const IVectorType tangent = vector_cast<IVectorType>(m_tangent);
+
+        ArclengthMap<IMapT> system(interval_map, tangent, point);
+        KrawczykMethodExpander<ArclengthMap<IMapT>> expander(system);
+
+        enclosure = point;
+        return expander.bound_solution(enclosure, point, krawczyk_steps);
+    }
+
+    const VectorType& get_point() const noexcept
+    {
+        return m_point;
+    }
+
+    const VectorType& get_tangent() const noexcept
+    {
+        return m_tangent;
+    }
+
+    const ScalarType& get_step() const noexcept
+    {
+        return m_step;
+    }
+
+private:
+    ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    //! @brief Compute tangent at m_point oriented consistently with previous one: [ DF(x); t_prev ] * t = e_{n+1}
+    //!
+    //! The factorization is kept as the corrector preconditioner.
+    ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    void update_tangent()
+    {
+        ArclengthMap<MapT> system(m_map, m_tangent, m_point);
+
+        MatrixType der(system.dimension(), system.dimension());
+        system(m_point, der);
+
+        m_solver = std::make_unique<GaussMatrixSolver<MapT>>(der);
+
+        VectorType rhs(system.dimension());
+        rhs[system.dimension() - 1] = 1.0;
+
+        const VectorType tangent = m_solver->solve(rhs);
+        m_tangent = tangent / capd::vectalg::euclNorm(tangent);
+    }
+
+    ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    //! @brief Chord iterations preconditioned by `solver`
+    //!
+    //! @return false if the iterations do not converge or fail (e.g. singular matrix)
+    ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    bool correct(
+        ArclengthMap<MapT>& system,
+        const GaussMatrixSolver<MapT>& solver,
+        const VectorType& start,
+        VectorType& out,
+        size_t& iterations) const
+    {
+        try
+        {
+            MaxNorm<MapT> norm {};
+
+            VectorType x = start;
+            ScalarType last_norm = norm(system(x));
+
+            for (iterations = 1; iterations <= m_parameters.max_corrector_steps; ++iterations)
+            {
+                x -= solver.solve(system(x));
+
+                const ScalarType value_norm = norm(system(x));
+
+                if (value_norm < m_parameters.tolerance)
+                {
+                    out = x;
+                    return true;
+                }
+
+                if (!(value_norm < last_norm))
+                {
+                    return false;
+                }
+
+                last_norm = value_norm;
+            }
+
+            return false;
+        }
+        catch (const std::runtime_error&)
+        {
+            return false;
+        }
+    }
+
+    ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    //! @brief Chord iterations preconditioned by factorization of the Jacobian at `start` (m_solver is not changed)
+    ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    bool refactorize_and_correct(
+        ArclengthMap<MapT>& system,
+        const VectorType& start,
+        VectorType& out,
+        size_t& iterations) const
+    {
+        try
+        {
+            MatrixType der(system.dimension(), system.dimension());
+            system(start, der);
+
+            const GaussMatrixSolver<MapT> solver(der);
+            return correct(system, solver, start, out, iterations);
+        }
+        catch (const std::runtime_error&)
+        {
+            return false;
+        }
+    }
+
+    MapT& m_map;
+    const ContinuationParameters<ScalarType> m_parameters;
+
+    VectorType m_point;
+    VectorType m_tangent;
+    ScalarType m_step;
+
+    //! Factorization of the bordered Jacobian at m_point (see update_tangent)
+    std::unique_ptr<GaussMatrixSolver<MapT>> m_solver;
+};
+
+}
@@ -4,6 +4,13 @@
 
 #pragma once
 
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <iterator>
+#include <stdexcept>
+#include <vector>
+
 #include "capd/basic_types.hpp"
 
 namespace CapdUtils
@@ -11,45 +18,176 @@ namespace CapdUtils
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 //! Covering factors
+//!
+//! For each coordinate the image Y is mapped affinely onto [-1, 1] with respect to X, so factors are positive if Y covers
+//! X with a margin on both sides. `internal` is the minimal and `external` the maximal factor over all coordinates.
 ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
-struct CoveringFactors
+template<typename IntervalT>
+struct BasicCoveringFactors
 {
-    Real internal;
-    Real external;
+    static_assert(capd::TypeTraits<IntervalT>::isInterval, "Covering factors are implemented for intervals only!");
 
-    CoveringFactors(const Interval& X, const Interval& Y) : internal(NAN), external(NAN)
-    {
-        auto f = [&X](Real x) -> Real
-        {
-            return (2*x - X.leftBound() - X.rightBound()) / (X.rightBound() - X.leftBound());
-        };
+    using BoundType = typename IntervalT::BoundType;
+    using VectorType = capd::vectalg::Vector<IntervalT, 0>;
+
+    BoundType internal;
+    BoundType external;
 
-        const Real a = -f( Y.leftBound()  ) - 1.0;
-        const Real b = +f( Y.rightBound() ) - 1.0;
+    BasicCoveringFactors(const BoundType& internal_factor, const BoundType& external_factor)
+        : internal(internal_factor)
+        , external(external_factor)
+    {}
 
-        internal = std::min(a,b);
-        external = std::max(a,b);
+    BasicCoveringFactors(const IntervalT& X, const IntervalT& Y) : internal(NAN), external(NAN)
+    {
+        const BoundType a = factor_left(X.leftBound(), X.rightBound(), Y.leftBound());
+        const BoundType b = factor_right(X.leftBound(), X.rightBound(), Y.rightBound());
+
+        internal = std::min<BoundType>(a,b);
+        external = std::max<BoundType>(a,b);
     }
 
-    CoveringFactors(const IVector& X, const IVector& Y) : internal(NAN), external(NAN)
+    BasicCoveringFactors(const VectorType& X, const VectorType& Y) : internal(NAN), external(NAN)
     {
         assert( X.dimension() == Y.dimension() );
 
         if (X.dimension() > 0)
         {
             {
-                CoveringFactors cf( X[0], Y[0] );
+                BasicCoveringFactors cf( X[0], Y[0] );
                 *this = cf;
             }
 
             for (unsigned i = 1; i < X.dimension(); ++i)
             {
-                CoveringFactors cf( X[i], Y[i] );
-                internal = std::min(this->internal, cf.internal);
-                external = std::max(this->external, cf.external);
+                BasicCoveringFactors cf( X[i], Y[i] );
+                internal = std::min<BoundType>(this->internal, cf.internal);
+                external = std::max<BoundType>(this->external, cf.external);
             }
         }
     }
+
+    static BoundType factor_left(const BoundType& x_left, const BoundType& x_right, const BoundType& y_left)
+    {
+        return -(2*y_left - x_left - x_right) / (x_right - x_left) - 1.0;
+    }
+
+    static BoundType factor_right(const BoundType& x_left, const BoundType& x_right, const BoundType& y_right)
+    {
+        return (2*y_right - x_left - x_right) / (x_right - x_left) - 1.0;
+    }
+};
+
+using CoveringFactors = BasicCoveringFactors<Interval>;
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//! Covering factors of many image boxes (e.g. images of GridMap sub-boxes) with respect to single box X
+//!
+//! Bounds of the images are stored coordinate-wise (structure of arrays), so the factors are evaluated by tight loops over
+//! contiguous arrays which the compiler vectorizes for built-in bound types.
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+template<typename IntervalT>
+class CoveringFactorsBatch
+{
+public:
+    using BoundType = typename IntervalT::BoundType;
+    using VectorType = capd::vectalg::Vector<IntervalT, 0>;
+    using Factors = BasicCoveringFactors<IntervalT>;
+
+    template<typename It>
+    CoveringFactorsBatch(const VectorType& X, It Y_begin, It Y_end)
+        : m_internal(std::distance(Y_begin, Y_end), BoundType(INFINITY))
+        , m_external(m_internal.size(), BoundType(-INFINITY))
+    {
+        const size_t boxes = m_internal.size();
+        const unsigned dimension = X.dimension();
+
+        std::vector<BoundType> lefts(boxes);
+        std::vector<BoundType> rights(boxes);
+
+        for (unsigned i = 0; i < dimension; ++i)
+        {
+            size_t k = 0;
+            for (It it = Y_begin; it != Y_end; ++it, ++k)
+            {
+                if (it->dimension() != dimension)
+                {
+                    throw std::logic_error("CoveringFactorsBatch: box dimension mismatch!");
+                }
+
+                lefts[k] = (*it)[i].leftBound();
+                rights[k] = (*it)[i].rightBound();
+            }
+
+            const BoundType x_left = X[i].leftBound();
+            const BoundType x_right = X[i].rightBound();
+
+            for (size_t k = 0; k < boxes; ++k)
+            {
+                const BoundType a = Factors::factor_left(x_left, x_right, lefts[k]);
+                const BoundType b = Factors::factor_right(x_left, x_right, rights[k]);
+
+                m_internal[k] = std::min<BoundType>(m_internal[k], std::min<BoundType>(a, b));
+                m_external[k] = std::max<BoundType>(m_external[k], std::max<BoundType>(a, b));
+            }
+        }
+    }
+
+    CoveringFactorsBatch(const VectorType& X, const std::vector<VectorType>& Y)
+        : CoveringFactorsBatch(X, Y.begin(), Y.end())
+    {}
+
+    size_t size() const noexcept
+    {
+        return m_internal.size();
+    }
+
+    Factors get(size_t k) const
+    {
+        return Factors(m_internal.at(k), m_external.at(k));
+    }
+
+    ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    //! @brief Index of the box with the smallest internal factor
+    ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    size_t get_worst_index() const
+    {
+        if (m_internal.empty())
+        {
+            throw std::logic_error("CoveringFactorsBatch: no boxes!");
+        }
+
+        return std::distance(m_internal.begin(), std::min_element(m_internal.begin(), m_internal.end()));
+    }
+
+    ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    //! @brief Factors of the whole batch (minimal internal and maximal external factor)
+    ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    Factors get_total() const
+    {
+        if (m_internal.empty())
+        {
+            throw std::logic_error("CoveringFactorsBatch: no boxes!");
+        }
+
+        return Factors(
+            *std::min_element(m_internal.begin(), m_internal.end()),
+            *std::max_element(m_external.begin(), m_external.end()));
+    }
+
+    const std::vector<BoundType>& get_internal() const noexcept
+    {
+        return m_internal;
+    }
+
+    const std::vector<BoundType>& get_external() const noexcept
+    {
+        return m_external;
+    }
+
+private:
+    std::vector<BoundType> m_internal;
+    std::vector<BoundType> m_external;
 };
 
 }
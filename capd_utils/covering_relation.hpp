@@ -0,0 +1,328 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Author: Aleksander M. Pasiut
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <iterator>
+#include <list>
+#include <stdexcept>
+#include <vector>
+
+#include "capd/basic_types.hpp"
+#include "covering_factors.hpp"
+#include "execution_policy.hpp"
+#include "grid_map.hpp"
+
+namespace CapdUtils
+{
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//! @brief Covering relation checker
+//!
+//! @details The map is given in local coordinates (e.g. LocalMap), where both h-sets are N = [-1,1]^n with first `u`
+//!          coordinates unstable and remaining coordinates stable. The following conditions are verified:
+//!
+//!          - for each unstable coordinate j the image of the face x_j = -1 satisfies f_j < -1 and the image of the face
+//!            x_j = +1 satisfies f_j > 1,
+//!          - stable coordinates of the image of N are contained in (-1,1).
+//!
+//!          For u = 1 these are the conditions of the covering relation of Zgliczynski and Gidea (with the linear
+//!          homotopy). Faces and N are split by the grid (see GridMap) and the boxes are evaluated in chunks of
+//!          `batch_size`. The margin (distance by which the condition is satisfied) of each box is its covering factor
+//!          with respect to [-1,1] (see BasicCoveringFactors):
+//!
+//!          - face x_j = -1: left factor of the right bound of f_j (i.e. -1 - f_j), face x_j = +1: right factor of the
+//!            left bound of f_j (i.e. f_j - 1), so the face is mapped beyond its side iff the factor is positive,
+//!          - N: negated external factor of the stable coordinates computed by CoveringFactorsBatch, positive iff they
+//!            are contained in (-1,1).
+//!
+//!          The margin is reduced incrementally by the worst box of each chunk. The check stops on the first chunk
+//!          containing a box violating the conditions; faces are checked before the interior, as they fail most often.
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+template<typename MapT>
+class CoveringRelation
+{
+public:
+    using ScalarType = typename MapT::ScalarType;
+    using VectorType = typename MapT::VectorType;
+    using MatrixType = typename MapT::MatrixType;
+
+    using BoundType = typename ScalarType::BoundType;
+
+    static_assert(capd::TypeTraits<ScalarType>::isInterval, "CoveringRelation is implemented for intervals only!");
+
+    struct Result
+    {
+        bool is_covering;
+
+        //! Minimal margin of all evaluated boxes (the first violating one, if the check failed)
+        BoundType margin;
+
+        //! Box with minimal margin
+        VectorType worst_box;
+    };
+
+    ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    //! @brief Constructor
+    //!
+    //! @param dimension          dimension of h-sets
+    //! @param unstable_dimension number of unstable coordinates (leading ones)
+    //! @param grid               number of subdivisions of each coordinate
+    //! @param batch_size         number of boxes evaluated before the margin is checked
+    ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    CoveringRelation(unsigned dimension, unsigned unstable_dimension, const std::vector<int>& grid, size_t batch_size = 16)
+        : m_dimension(dimension)
+        , m_unstable_dimension(unstable_dimension)
+    {
+        if (batch_size == 0)
+        {
+            throw std::invalid_argument("CoveringRelation: batch size must be greater than 0!");
+        }
+
+        if (unstable_dimension > dimension)
+        {
+            throw std::logic_error("CoveringRelation: unstable dimension exceeds dimension!");
+        }
+
+        if (grid.size() != dimension)
+        {
+            throw std::logic_error("CoveringRelation: mismatch of dimension and grid dimension!");
+        }
+
+        VectorType h_set(dimension);
+        for (unsigned i = 0; i < dimension; ++i)
+        {
+            h_set[i] = ScalarType(-1.0, 1.0);
+        }
+
+        for (unsigned j = 0; j < unstable_dimension; ++j)
+        {
+            std::vector<int> face_grid = grid;
+            face_grid[j] = 1;
+
+            for (int side : { -1, 1 })
+            {
+                VectorType face = h_set;
+                face[j] = ScalarType( BoundType(side) );
+
+                add_chunks(GridMap<MapT>::split(face, face_grid), static_cast<int>(j), side, batch_size);
+            }
+        }
+
+        if (unstable_dimension < dimension)
+        {
+            add_chunks(GridMap<MapT>::split(h_set, grid), -1, 0, batch_size);
+        }
+    }
+
+    ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    //! @brief Check covering relation for `map`
+    ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    Result check(MapT& map) const
+    {
+        check_map(map);
+
+        Result ret { true, BoundType(INFINITY), VectorType() };
+
+        for (const Chunk& chunk : m_chunks)
+        {
+            reduce(ret, chunk, get_margins(map, chunk));
+
+            if (ret.is_covering == false)
+            {
+                return ret;
+            }
+        }
+
+        return ret;
+    }
+
+    ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    //! @brief Check covering relation with chunks of boxes evaluated according to `policy`
+    //!
+    //! Maps are usually not thread-safe, so each chunk is evaluated by its own map returned (by value) from
+    //! `make_map()`. Chunks are reduced in order, so the result does not depend on the policy; once a chunk violating
+    //! the conditions is found, the chunks which have not started yet are skipped.
+    ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    template<typename MapFactoryT, typename PolicyT = SequentialExecution>
+    Result check(MapFactoryT make_map, PolicyT policy = PolicyT()) const
+    {
+        std::vector<std::vector<BoundType>> margins(m_chunks.size());
+        std::atomic<bool> failed { false };
+
+        policy.run(m_chunks.size(), [&](size_t i)
+        {
+            if (failed == false)
+            {
+                auto map = make_map();
+                check_map(map);
+
+                margins[i] = get_margins(map, m_chunks[i]);
+
+                if (!(*std::min_element(margins[i].begin(), margins[i].end()) > 0))
+                {
+                    failed = true;
+                }
+            }
+        });
+
+        Result ret { true, BoundType(INFINITY), VectorType() };
+
+        for (size_t i = 0; i < m_chunks.size() && ret.is_covering; ++i)
+        {
+            if (margins[i].empty() == false)
+            {
+                reduce(ret, m_chunks[i], margins[i]);
+            }
+        }
+
+        return ret;
+    }
+
+    size_t get_boxes_count() const noexcept
+    {
+        size_t ret = 0;
+
+        for (const Chunk& chunk : m_chunks)
+        {
+            ret += chunk.boxes.size();
+        }
+
+        return ret;
+    }
+
+private:
+    //! Boxes of single face or of N, evaluated together
+    struct Chunk
+    {
+        std::vector<VectorType> boxes;
+
+        //! Unstable coordinate fixed on the face or -1 for boxes of N
+        int coordinate;
+
+        //! Side of the face (-1 or 1)
+        int side;
+    };
+
+    void add_chunks(const std::list<VectorType>& boxes, int coordinate, int side, size_t batch_size)
+    {
+        for (const VectorType& box : boxes)
+        {
+            if (m_chunks.empty() || m_chunks.back().boxes.size() == batch_size ||
+                m_chunks.back().coordinate != coordinate || m_chunks.back().side != side)
+            {
+                m_chunks.push_back({ {}, coordinate, side });
+                m_chunks.back().boxes.reserve(batch_size);
+            }
+
+            m_chunks.back().boxes.push_back(box);
+        }
+    }
+
+    template<typename MapU>
+    void check_map(const MapU& map) const
+    {
+        if (map.dimension() != m_dimension || map.imageDimension() != m_dimension)
+        {
+            throw std::logic_error("CoveringRelation: map dimension mismatch!");
+        }
+    }
+
+    ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    //! @brief Margins of all boxes of `chunk` (see the class description)
+    ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    template<typename MapU>
+    std::vector<BoundType> get_margins(MapU& map, const Chunk& chunk) const
+    {
+        if (chunk.coordinate >= 0)
+        {
+            return get_face_margins(map, chunk);
+        }
+
+        const unsigned dimension = m_dimension - m_unstable_dimension;
+
+        VectorType h_set(dimension);
+        for (unsigned i = 0; i < dimension; ++i)
+        {
+            h_set[i] = ScalarType(-1.0, 1.0);
+        }
+
+        std::vector<VectorType> images {};
+        images.reserve(chunk.boxes.size());
+
+        for (const VectorType& box : chunk.boxes)
+        {
+            const VectorType img = map(box);
+
+            VectorType y(dimension);
+            for (unsigned i = 0; i < dimension; ++i)
+            {
+                y[i] = img[m_unstable_dimension + i];
+            }
+
+            images.push_back(y);
+        }
+
+        std::vector<BoundType> ret = CoveringFactorsBatch<ScalarType>(h_set, images).get_external();
+
+        for (BoundType& margin : ret)
+        {
+            margin = -margin;
+        }
+
+        return ret;
+    }
+
+    ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    //! @brief Margins of boxes of the face x_j = side, i.e. -1 - f_j for side -1 and f_j - 1 for side 1
+    ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    template<typename MapU>
+    std::vector<BoundType> get_face_margins(MapU& map, const Chunk& chunk) const
+    {
+        using Factors = BasicCoveringFactors<ScalarType>;
+
+        const BoundType x_left(-1.0);
+        const BoundType x_right(1.0);
+
+        std::vector<BoundType> ret {};
+        ret.reserve(chunk.boxes.size());
+
+        for (const VectorType& box : chunk.boxes)
+        {
+            const ScalarType f = map(box)[chunk.coordinate];
+
+            ret.push_back(chunk.side < 0
+                ? Factors::factor_left(x_left, x_right, f.rightBound())
+                : Factors::factor_right(x_left, x_right, f.leftBound()));
+        }
+
+        return ret;
+    }
+
+    static void reduce(Result& ret, const Chunk& chunk, const std::vector<BoundType>& margins)
+    {
+        const size_t worst = std::distance(margins.begin(), std::min_element(margins.begin(), margins.end()));
+
+        if (margins[worst] < ret.margin)
+        {
+            ret.margin = margins[worst];
+            ret.worst_box = chunk.boxes[worst];
+        }
+
+        if (!(margins[worst] > 0))
+        {
+            ret.is_covering = false;
+        }
+    }
+
+    const unsigned m_dimension;
+    const unsigned m_unstable_dimension;
+
+    std::vector<Chunk> m_chunks;
+};
+
+}
@@ -4,8 +4,14 @@
 
 #pragma once
 
+#include <array>
+#include <string>
+#include <tuple>
+
 #include "map_base.hpp"
 #include "map_compatibility.hpp"
+#include "map_tuple.hpp"
+#include "execution_policy.hpp"
 
 #include "extract.hpp"
 #include "concat.hpp"
@@ -19,31 +25,45 @@ namespace CapdUtils
 //!
 //!     F(x_1, ..., x_n) = [ f_1 (x_1), ..., f_n (x_n) ]
 //!
+//!  Maps are stored in a flat tuple and offsets of arguments and images are computed at construction, so each map writes
+//!  its value and derivative directly into the preallocated output.
+//!
+//!  Maps are evaluated according to PolicyT (SequentialExecution or ParallelExecution). Each map writes to its own block of
+//!  the output, so no synchronization is needed; with ParallelExecution the maps must not share state (e.g. the same
+//!  solver object referenced twice).
 ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
-template<typename MapT, typename MapU, typename... MapV>
-class DirectSum : public MapBase<MapT>
+template<typename PolicyT, typename MapT, typename MapU, typename... MapV>
+class BasicDirectSum : public MapBase<MapT>
 {
 public:
-    static_assert(MapCompatibility<MapT, MapU>::value);
+    static_assert(MapCompatibility<MapT, MapU>::value && (MapCompatibility<MapT, MapV>::value && ...));
 
     using ScalarType = typename MapT::ScalarType;
     using VectorType = typename MapT::VectorType;
     using MatrixType = typename MapT::MatrixType;
 
-    DirectSum(MapU map_1, MapV... map_2_args) : m_map_1(map_1), m_map_2(map_2_args...)
+    BasicDirectSum(MapU map_1, MapV... map_2_args) : BasicDirectSum(PolicyT(), map_1, map_2_args...)
+    {}
+
+    BasicDirectSum(PolicyT policy, MapU map_1, MapV... map_2_args)
+        : m_policy(policy)
+        , m_maps(map_1, map_2_args...)
+        , m_in_offsets( get_map_offsets(m_maps, [](const auto& map) { return map.dimension(); }) )
+        , m_out_offsets( get_map_offsets(m_maps, [](const auto& map) { return map.imageDimension(); }) )
     {}
 
     VectorType operator() (const VectorType& vec) override
     {
         this->assert_vector_size(vec, this->dimension(), "DirectSum vec vector size mismatch (1)!");
 
-        const VectorType arg1 = Extract<MapT>::get_vector(vec, 0, m_map_1.dimension());
-        const VectorType arg2 = Extract<MapT>::get_vector(vec, m_map_1.dimension(), m_map_2.dimension());
+        VectorType ret( this->imageDimension() );
 
-        const VectorType v1 = m_map_1(arg1);
-        const VectorType v2 = m_map_2(arg2);
+        evaluate([&](auto& map, size_t i)
+        {
+            const VectorType arg = Extract<MapT>::get_vector(vec, m_in_offsets[i], m_in_offsets[i+1] - m_in_offsets[i]);
+            Concat<MapT>::copy_vector_on_vector(ret, map(arg), m_out_offsets[i]);
+        });
 
-        const VectorType ret = Concat<MapT>::concat_vectors({ v1, v2 });
         return ret;
     }
 
@@ -51,82 +71,68 @@ public:
     {
         this->assert_vector_size(vec, this->dimension(), "DirectSum vec vector size mismatch (2)!");
 
-        const VectorType arg1 = Extract<MapT>::get_vector(vec, 0, m_map_1.dimension());
-        const VectorType arg2 = Extract<MapT>::get_vector(vec, m_map_1.dimension(), m_map_2.dimension());
+        VectorType ret( this->imageDimension() );
+        assign_zero(mat, this->imageDimension(), this->dimension());
 
-        MatrixType m1(m_map_1.imageDimension(), m_map_1.dimension());
-        const VectorType v1 = m_map_1(arg1, m1);
-        this->assert_matrix_size(m1, m_map_1.imageDimension(), m_map_1.dimension(), "DirectSum m1 matrix size mismatch!");
+        evaluate([&](auto& map, size_t i)
+        {
+            const unsigned rows = m_out_offsets[i+1] - m_out_offsets[i];
+            const unsigned cols = m_in_offsets[i+1] - m_in_offsets[i];
 
-        MatrixType m2(m_map_2.imageDimension(), m_map_2.dimension());
-        const VectorType v2 = m_map_2(arg2, m2);
-        this->assert_matrix_size(m2, m_map_2.imageDimension(), m_map_2.dimension(), "DirectSum m2 matrix size mismatch!");
+            const VectorType arg = Extract<MapT>::get_vector(vec, m_in_offsets[i], cols);
 
-        const VectorType ret = Concat<MapT>::concat_vectors({ v1, v2 });
+            MatrixType& der = m_ders[i];
+            if (der.dimension() != std::make_pair(rows, cols))
+            {
+                der = MatrixType(rows, cols);
+            }
+
+            Concat<MapT>::copy_vector_on_vector(ret, map(arg, der), m_out_offsets[i]);
+            this->assert_matrix_size(der, rows, cols, "DirectSum m" + std::to_string(i+1) + " matrix size mismatch!");
+
+            Concat<MapT>::copy_matrix_on_matrix(mat, der, m_out_offsets[i], m_in_offsets[i]);
+        });
 
-        mat = MatrixType(this->imageDimension(), this->dimension());
-        Concat<MapT>::copy_matrix_on_matrix(mat, m1, 0, 0);
-        Concat<MapT>::copy_matrix_on_matrix(mat, m2, m_map_1.imageDimension(), m_map_1.dimension());
         return ret;
     }
 
     unsigned dimension() const noexcept override
     {
-        return m_map_1.dimension() + m_map_2.dimension();
+        return m_in_offsets.back();
     }
 
     unsigned imageDimension() const noexcept override
     {
-        return m_map_1.imageDimension() + m_map_2.imageDimension();
+        return m_out_offsets.back();
     }
 
 private:
-    MapU m_map_1;
-    DirectSum<MapT, MapV...> m_map_2;
-};
-
-
-template<typename MapT, typename MapU>
-class DirectSum<MapT, MapU> : public MapBase<MapT>
-{
-public:
-    static_assert(MapCompatibility<MapT, MapU>::value);
-
-    using ScalarType = typename MapT::ScalarType;
-    using VectorType = typename MapT::VectorType;
-    using MatrixType = typename MapT::MatrixType;
-
-    DirectSum(MapU map) : m_map(map)
-    {}
+    static constexpr size_t m_size = 1 + sizeof...(MapV);
 
-    VectorType operator() (const VectorType& vec) override
+    //! Evaluate func(map, index) for all maps according to the execution policy
+    template<typename FuncT>
+    void evaluate(FuncT&& func)
     {
-        this->assert_vector_size(vec, m_map.dimension(), "DirectSum vec vector size mismatch (1)!");
-        return m_map(vec);
+        m_policy.run(m_size, [&](size_t index)
+        {
+            visit_map(m_maps, index, func);
+        });
     }
 
-    VectorType operator() (const VectorType& vec, MatrixType& mat) override
-    {
-        this->assert_vector_size(vec, m_map.dimension(), "DirectSum vec vector size mismatch (2)!");
+    PolicyT m_policy;
+    std::tuple<MapU, MapV...> m_maps;
 
-        const VectorType ret = m_map(vec, mat);
-        this->assert_matrix_size(mat, m_map.imageDimension(), m_map.dimension(), "DirectSum mat matrix size mismatch!");
+    const std::array<unsigned, m_size + 1> m_in_offsets;
+    const std::array<unsigned, m_size + 1> m_out_offsets;
 
-        return ret;
-    }
-
-    unsigned dimension() const noexcept override
-    {
-        return m_map.dimension();
-    }
+    //! Derivatives of maps (reused between evaluations)
+    std::array<MatrixType, m_size> m_ders {};
+};
 
-    unsigned imageDimension() const noexcept override
-    {
-        return m_map.imageDimension();
-    }
+template<typename MapT, typename MapU, typename... MapV>
+using DirectSum = BasicDirectSum<SequentialExecution, MapT, MapU, MapV...>;
 
-private:
-    MapU m_map;
-};
+template<typename MapT, typename MapU, typename... MapV>
+using ParallelDirectSum = BasicDirectSum<ParallelExecution, MapT, MapU, MapV...>;
 
 }
@@ -0,0 +1,241 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Author: Aleksander M. Pasiut
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "capd/basic_tools.hpp"
+#include "capd/gauss_solver.hpp"
+#include "eigenpair.hpp"
+
+namespace CapdUtils
+{
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//! @brief Rigorous enclosure of all eigenpairs of matrix A in one batch
+//!
+//! @details Let X be approximate eigenvector matrix, L approximate eigenvalues and R approximate inverse of X. The
+//!          matrices B = R*A*X and C = R*X are computed once and shared by all eigenpairs. If |I - C| < 1, then R and X
+//!          are nonsingular and A*x = lambda*x for x = X*v is equivalent to B*v = lambda*C*v.
+//!
+//!          For i-th eigenpair v = e_i + w (w_i = 0) and lambda = L_i + mu are enclosed by Krawczyk method for unknowns
+//!          z = (w with mu in place of w_i), preconditioned by diagonal P = diag(1/(L_j - L_i), -1) which is exact
+//!          inverse of the Jacobian for B = L and C = I. Therefore single pair costs O(n^2) per step.
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+template<typename MapT>
+class EigenproblemEnclosure
+{
+public:
+    using ScalarType = typename MapT::ScalarType;
+    using VectorType = typename MapT::VectorType;
+    using MatrixType = typename MapT::MatrixType;
+
+    static_assert(capd::TypeTraits<ScalarType>::isInterval, "EigenproblemEnclosure is implemented for intervals only!");
+
+    EigenproblemEnclosure(const MatrixType& arg) : m_arg(arg)
+    {}
+
+    ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    //! @brief Enclose all eigenpairs
+    //!
+    //! @param similarity_matrix approximate eigenvectors as columns (see Eigenproblem::create_similarity_matrix)
+    //! @param eigenvalues_matrix approximate eigenvalues on diagonal (see Eigenproblem::create_eigenvalues_matrix)
+    //! @param max_steps maximal number of epsilon inflation steps per eigenpair
+    //!
+    //! @return eigenpairs with normalized eigenvectors, ordered as columns of `similarity_matrix`
+    ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    std::vector<Eigenpair<MapT>> enclose(
+        const MatrixType& similarity_matrix,
+        const MatrixType& eigenvalues_matrix,
+        size_t max_steps) const
+    {
+        const unsigned n = check_dimensions(similarity_matrix, eigenvalues_matrix);
+
+        const MatrixType X = mid_matrix(similarity_matrix);
+        const MatrixType R = mid_matrix( gaussInverseMatrix<MapT>(X) );
+
+        const MatrixType B = (R * m_arg) * X;
+        const MatrixType C = R * X;
+
+        check_nonsingularity(C);
+
+        std::vector<ScalarType> lambdas(n + 1);
+        for (unsigned i = 1; i <= n; ++i)
+        {
+            lambdas[i] = middle( eigenvalues_matrix(i, i) );
+        }
+
+        std::vector<Eigenpair<MapT>> ret {};
+        ret.reserve(n);
+
+        for (unsigned i = 1; i <= n; ++i)
+        {
+            ret.emplace_back( enclose_single(i, X, B, C, lambdas, max_steps) );
+        }
+
+        return ret;
+    }
+
+private:
+    unsigned check_dimensions(const MatrixType& similarity_matrix, const MatrixType& eigenvalues_matrix) const
+    {
+        const unsigned n = m_arg.numberOfRows();
+
+        if (m_arg.numberOfColumns() != n ||
+            similarity_matrix.numberOfRows() != n || similarity_matrix.numberOfColumns() != n ||
+            eigenvalues_matrix.numberOfRows() != n || eigenvalues_matrix.numberOfColumns() != n)
+        {
+            throw std::logic_error("EigenproblemEnclosure: full set of eigenpairs of square matrix is required!");
+        }
+
+        return n;
+    }
+
+    static void check_nonsingularity(const MatrixType& C)
+    {
+        const unsigned n = C.numberOfRows();
+
+        for (unsigned r = 1; r <= n; ++r)
+        {
+            ScalarType row_sum(0.0);
+
+            for (unsigned j = 1; j <= n; ++j)
+            {
+                row_sum += abs( (r == j ? ScalarType(1.0) : ScalarType(0.0)) - C(r, j) );
+            }
+
+            if (!(row_sum.rightBound() < 1.0))
+            {
+                throw std::runtime_error("EigenproblemEnclosure: approximate eigenvector matrix is not well conditioned!");
+            }
+        }
+    }
+
+    Eigenpair<MapT> enclose_single(
+        unsigned i,
+        const MatrixType& X,
+        const MatrixType& B,
+        const MatrixType& C,
+        const std::vector<ScalarType>& lambdas,
+        size_t max_steps) const
+    {
+        const unsigned n = X.numberOfRows();
+
+        VectorType p(n);
+        for (unsigned j = 1; j <= n; ++j)
+        {
+            if (j == i)
+            {
+                p(j) = ScalarType(-1.0);
+            }
+            else if (lambdas[j].leftBound() != lambdas[i].leftBound())
+            {
+                p(j) = ScalarType(1.0) / (lambdas[j] - lambdas[i]);
+            }
+            else
+            {
+                throw std::runtime_error("EigenproblemEnclosure: multiple eigenvalue " + std::to_string(i) + "!");
+            }
+        }
+
+        // -P*F(0), where F(0) = B*e_i - L_i*C*e_i
+        VectorType shift(n);
+        for (unsigned r = 1; r <= n; ++r)
+        {
+            shift(r) = -p(r) * (B(r, i) - lambdas[i] * C(r, i));
+        }
+
+        VectorType z = inflate(shift);
+
+        for (size_t step = 0; step < max_steps; ++step)
+        {
+            const VectorType krawczyk = get_krawczyk(i, z, shift, p, B, C, lambdas[i]);
+
+            if ( capd::vectalg::subsetInterior(krawczyk, z) )
+            {
+                return create_eigenpair(i, krawczyk, X, lambdas[i]);
+            }
+
+            z = inflate( capd::vectalg::intervalHull(krawczyk, z) );
+        }
+
+        throw std::runtime_error("EigenproblemEnclosure: failed to enclose eigenpair " + std::to_string(i) + "!");
+    }
+
+    ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    //! @brief Krawczyk operator -P*F(0) + (I - P*J(z))*z
+    //!
+    //! @details Coefficients of I - P*J(z) are evaluated before multiplication by z, so the cancellation on the
+    //!          diagonal (P*J(z) is close to I) is not lost by interval arithmetic. The Jacobian is
+    //!          J_rj = B_rj - lambda(z)*C_rj for j != i and J_ri = -(C*v(z))_r.
+    ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    static VectorType get_krawczyk(
+        unsigned i,
+        const VectorType& z,
+        const VectorType& shift,
+        const VectorType& p,
+        const MatrixType& B,
+        const MatrixType& C,
+        const ScalarType& lambda)
+    {
+        const unsigned n = z.dimension();
+
+        VectorType v = z;
+        v(i) = ScalarType(1.0);
+
+        const ScalarType lambda_z = lambda + z(i);
+        const VectorType cv = C * v;
+
+        VectorType ret(n);
+        for (unsigned r = 1; r <= n; ++r)
+        {
+            ScalarType value = shift(r);
+
+            for (unsigned j = 1; j <= n; ++j)
+            {
+                const ScalarType jacobian = (j != i) ? B(r, j) - lambda_z * C(r, j) : -cv(r);
+                const ScalarType identity = (r == j) ? ScalarType(1.0) : ScalarType(0.0);
+
+                value += (identity - p(r) * jacobian) * z(j);
+            }
+
+            ret(r) = value;
+        }
+
+        return ret;
+    }
+
+    static VectorType inflate(const VectorType& arg)
+    {
+        VectorType ret(arg.dimension());
+
+        for (unsigned j = 0; j < arg.dimension(); ++j)
+        {
+            const ScalarType with_zero = capd::intervals::intervalHull(arg[j], ScalarType(0.0));
+            const auto radius = span(with_zero) / 10;
+
+            ret[j] = expand(with_zero + ScalarType(-radius, radius), 4);
+        }
+
+        return ret;
+    }
+
+    static Eigenpair<MapT> create_eigenpair(unsigned i, const VectorType& z, const MatrixType& X, const ScalarType& lambda)
+    {
+        VectorType v = z;
+        v(i) = ScalarType(1.0);
+
+        VectorType x = X * v;
+        x /= sqrt( capd::vectalg::scalarProduct(x, x) );
+
+        return Eigenpair<MapT>(x, lambda + z(i));
+    }
+
+    MatrixType m_arg;
+};
+
+}
@@ -0,0 +1,468 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Author: Aleksander M. Pasiut
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+
+#include "capd/basic_types.hpp"
+
+namespace CapdUtils
+{
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//! @brief Point eigenvalue solver based on Hessenberg reduction and shifted QR iteration
+//!
+//! @details The matrix A is reduced to upper Hessenberg form H = Q^T*A*Q by Householder reflections, then eigenvalues
+//!          of H are computed by Francis double shift QR iteration. Eigenvector for given real eigenvalue is computed
+//!          by inverse iteration on H (each step costs O(n^2) due to Hessenberg structure) and transformed back by Q.
+//!          All eigenpairs are therefore approximated in O(n^3) operations.
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+class HessenbergQR
+{
+public:
+    HessenbergQR(const RMatrix& arg)
+        : m_n(get_dimension(arg))
+        , m_hessenberg(arg)
+        , m_q(RMatrix::Identity(m_n))
+        , m_real_parts(m_n + 1, 0.0)
+        , m_imaginary_parts(m_n + 1, 0.0)
+    {
+        reduce_to_hessenberg();
+        compute_eigenvalues();
+    }
+
+    ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    //! @brief Get real eigenvalues (complex conjugate pairs are omitted)
+    ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    std::vector<Real> get_real_eigenvalues() const
+    {
+        std::vector<Real> ret {};
+
+        for (unsigned i = 1; i <= m_n; ++i)
+        {
+            if (m_imaginary_parts[i] == 0.0)
+            {
+                ret.push_back(m_real_parts[i]);
+            }
+        }
+
+        return ret;
+    }
+
+    ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    //! @brief Approximate normalized eigenvector of A for real eigenvalue `lambda` by inverse iteration
+    ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    RVector get_eigenvector(Real lambda, unsigned steps = 2) const
+    {
+        const Real eps = std::numeric_limits<Real>::epsilon() * norm();
+        const Real mu = lambda + eps;
+
+        RVector y(m_n);
+        for (unsigned i = 1; i <= m_n; ++i)
+        {
+            y(i) = 1.0;
+        }
+
+        for (unsigned s = 0; s < steps; ++s)
+        {
+            y = solve_shifted(mu, y, eps);
+            y /= capd::vectalg::euclNorm(y);
+        }
+
+        RVector ret = m_q * y;
+        ret /= capd::vectalg::euclNorm(ret);
+        return ret;
+    }
+
+private:
+    static unsigned get_dimension(const RMatrix& arg)
+    {
+        if (arg.numberOfRows() != arg.numberOfColumns())
+        {
+            throw std::logic_error("HessenbergQR is implemented for square matrices only!");
+        }
+
+        return arg.numberOfRows();
+    }
+
+    static Real sign(Real a, Real b)
+    {
+        return b >= 0.0 ? std::abs(a) : -std::abs(a);
+    }
+
+    Real norm() const
+    {
+        Real ret = 0.0;
+
+        for (unsigned i = 1; i <= m_n; ++i)
+        {
+            for (unsigned j = (i > 1 ? i-1 : 1); j <= m_n; ++j)
+            {
+                ret += std::abs(m_hessenberg(i, j));
+            }
+        }
+
+        return ret > 0.0 ? ret : 1.0;
+    }
+
+    ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    //! @brief Reduce m_hessenberg by Householder reflections accumulated in m_q
+    ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    void reduce_to_hessenberg()
+    {
+        RMatrix& h = m_hessenberg;
+
+        for (unsigned k = 1; k + 2 <= m_n; ++k)
+        {
+            Real alpha = 0.0;
+            for (unsigned i = k+1; i <= m_n; ++i)
+            {
+                alpha += h(i, k) * h(i, k);
+            }
+            alpha = -sign(std::sqrt(alpha), h(k+1, k));
+
+            std::vector<Real> v(m_n + 1, 0.0);
+            for (unsigned i = k+1; i <= m_n; ++i)
+            {
+                v[i] = h(i, k);
+            }
+            v[k+1] -= alpha;
+
+            Real v_norm_sqr = 0.0;
+            for (unsigned i = k+1; i <= m_n; ++i)
+            {
+                v_norm_sqr += v[i] * v[i];
+            }
+
+            if (v_norm_sqr == 0.0)
+            {
+                continue;
+            }
+
+            // H = (I - 2vv^T/v^Tv) * H
+            for (unsigned j = k; j <= m_n; ++j)
+            {
+                Real s = 0.0;
+                for (unsigned i = k+1; i <= m_n; ++i)
+                {
+                    s += v[i] * h(i, j);
+                }
+
+                s *= 2.0 / v_norm_sqr;
+                for (unsigned i = k+1; i <= m_n; ++i)
+                {
+                    h(i, j) -= s * v[i];
+                }
+            }
+
+            // H = H * (I - 2vv^T/v^Tv) and Q = Q * (I - 2vv^T/v^Tv)
+            for (RMatrix* m : { &h, &m_q })
+            {
+                for (unsigned i = 1; i <= m_n; ++i)
+                {
+                    Real s = 0.0;
+                    for (unsigned j = k+1; j <= m_n; ++j)
+                    {
+                        s += (*m)(i, j) * v[j];
+                    }
+
+                    s *= 2.0 / v_norm_sqr;
+                    for (unsigned j = k+1; j <= m_n; ++j)
+                    {
+                        (*m)(i, j) -= s * v[j];
+                    }
+                }
+            }
+
+            for (unsigned i = k+2; i <= m_n; ++i)
+            {
+                h(i, k) = 0.0;
+            }
+        }
+    }
+
+    ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    //! @brief Compute eigenvalues of Hessenberg matrix by Francis double shift QR iteration
+    //!
+    //! @details Implicit double shift QR steps (Golub, Van Loan, Matrix Computations, 7.5) are applied to the active
+    //!          unreduced block h(lo:hi, lo:hi). The block is shrunk whenever negligible subdiagonal entry splits off
+    //!          1x1 or 2x2 block, whose eigenvalues are stored. Only eigenvalues are needed, hence the reflections are
+    //!          applied to the active block only.
+    ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    void compute_eigenvalues()
+    {
+        RMatrix h = m_hessenberg;
+        const Real h_norm = norm();
+
+        unsigned hi = m_n;
+        unsigned iterations = 0;
+
+        while (hi >= 1)
+        {
+            const unsigned lo = find_split(h, hi, h_norm);
+
+            if (lo == hi)
+            {
+                m_real_parts[hi] = h(hi, hi);
+                m_imaginary_parts[hi] = 0.0;
+
+                hi -= 1;
+                iterations = 0;
+            }
+            else if (lo + 1 == hi)
+            {
+                store_block_eigenvalues(h, hi);
+
+                hi -= 2;
+                iterations = 0;
+            }
+            else
+            {
+                if (iterations == max_iterations)
+                {
+                    throw std::runtime_error("HessenbergQR: too many iterations!");
+                }
+
+                ++iterations;
+                francis_step(h, lo, hi, iterations % 10 == 0);
+            }
+        }
+    }
+
+    ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    //! @brief First row of the unreduced block ending at row `hi` (negligible subdiagonal entries are set to zero)
+    ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    static unsigned find_split(RMatrix& h, unsigned hi, Real h_norm)
+    {
+        const Real eps = std::numeric_limits<Real>::epsilon();
+
+        for (unsigned k = hi; k >= 2; --k)
+        {
+            Real scale = std::abs(h(k-1, k-1)) + std::abs(h(k, k));
+            if (scale == 0.0)
+            {
+                scale = h_norm;
+            }
+
+            if (std::abs(h(k, k-1)) <= eps * scale)
+            {
+                h(k, k-1) = 0.0;
+                return k;
+            }
+        }
+
+        return 1;
+    }
+
+    ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    //! @brief Store eigenvalues of 2x2 block h(hi-1:hi, hi-1:hi)
+    ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    void store_block_eigenvalues(const RMatrix& h, unsigned hi)
+    {
+        // eigenvalues are d + p +- sqrt(p^2 + bc) for block [a b; c d] and p = (a - d) / 2
+        const Real a = h(hi-1, hi-1);
+        const Real b = h(hi-1, hi);
+        const Real c = h(hi, hi-1);
+        const Real d = h(hi, hi);
+
+        const Real p = 0.5 * (a - d);
+        const Real discriminant = p * p + b * c;
+
+        if (discriminant >= 0.0)
+        {
+            // the root of larger magnitude is computed directly, the other one from the product of roots (-bc)
+            const Real larger = p + sign(std::sqrt(discriminant), p);
+
+            m_real_parts[hi-1] = d + larger;
+            m_real_parts[hi] = (larger != 0.0) ? d - b * c / larger : d;
+            m_imaginary_parts[hi-1] = 0.0;
+            m_imaginary_parts[hi] = 0.0;
+        }
+        else
+        {
+            const Real imaginary = std::sqrt(-discriminant);
+
+            m_real_parts[hi-1] = d + p;
+            m_real_parts[hi] = d + p;
+            m_imaginary_parts[hi-1] = imaginary;
+            m_imaginary_parts[hi] = -imaginary;
+        }
+    }
+
+    ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    //! @brief Single implicit double shift QR step on unreduced block h(lo:hi, lo:hi) of size at least 3
+    //!
+    //! @details The shifts are eigenvalues of the trailing 2x2 block (given by their sum `s` and product `t`), or ad hoc
+    //!          values if `exceptional` is set, which breaks cycles occurring for some matrices. The first column of
+    //!          (H - s1 I)(H - s2 I) is mapped on e1 by reflection, then the bulge is chased down the subdiagonal.
+    ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    static void francis_step(RMatrix& h, unsigned lo, unsigned hi, bool exceptional)
+    {
+        Real s = h(hi-1, hi-1) + h(hi, hi);
+        Real t = h(hi-1, hi-1) * h(hi, hi) - h(hi-1, hi) * h(hi, hi-1);
+
+        if (exceptional)
+        {
+            // shifts of trailing block replaced by [c -0.4375m; m c], where m is magnitude of subdiagonal entries
+            const Real magnitude = std::abs(h(hi, hi-1)) + std::abs(h(hi-1, hi-2));
+            const Real c = 0.75 * magnitude + h(hi, hi);
+            s = 2.0 * c;
+            t = c * c + 0.4375 * magnitude * magnitude;
+        }
+
+        Real x = h(lo, lo) * h(lo, lo) + h(lo, lo+1) * h(lo+1, lo) - s * h(lo, lo) + t;
+        Real y = h(lo+1, lo) * (h(lo, lo) + h(lo+1, lo+1) - s);
+        Real z = h(lo+1, lo) * h(lo+2, lo+1);
+
+        for (unsigned k = lo; k + 2 <= hi; ++k)
+        {
+            const Real v[3] = { x, y, z };
+            apply_reflection(h, v, 3, k, lo, hi);
+
+            x = h(k+1, k);
+            y = h(k+2, k);
+            if (k + 3 <= hi)
+            {
+                z = h(k+3, k);
+            }
+        }
+
+        // final 2x2 reflection removes the remaining bulge entry h(hi, hi-2)
+        const Real v[3] = { x, y, 0.0 };
+        apply_reflection(h, v, 2, hi-1, lo, hi);
+    }
+
+    ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    //! @brief Similarity by reflection P mapping vector `v` (of length `rows`) on multiple of e1, acting on rows/columns
+    //!        k, ..., k+rows-1 of the active block h(lo:hi, lo:hi)
+    //!
+    //! @details For k > lo the vector `v` is taken from column k-1, which is reduced to (alpha, 0, ..., 0).
+    ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    static void apply_reflection(RMatrix& h, const Real (&v)[3], unsigned rows, unsigned k, unsigned lo, unsigned hi)
+    {
+        const Real v_norm = std::sqrt(v[0] * v[0] + v[1] * v[1] + v[2] * v[2]);
+
+        if (v_norm == 0.0)
+        {
+            return;
+        }
+
+        // w = v - alpha e1 with alpha of the sign opposite to v[0] (no cancellation), P = I - beta w w^T
+        const Real alpha = -sign(v_norm, v[0]);
+        const Real w[3] = { v[0] - alpha, v[1], v[2] };
+        const Real beta = 2.0 / (w[0] * w[0] + w[1] * w[1] + w[2] * w[2]);
+
+        // H = P * H (columns left of k-1 are zero in these rows)
+        for (unsigned j = (k > lo ? k-1 : lo); j <= hi; ++j)
+        {
+            Real dot = 0.0;
+            for (unsigned i = 0; i < rows; ++i)
+            {
+                dot += w[i] * h(k+i, j);
+            }
+
+            dot *= beta;
+            for (unsigned i = 0; i < rows; ++i)
+            {
+                h(k+i, j) -= dot * w[i];
+            }
+        }
+
+        // H = H * P (rows below k+rows are zero in these columns)
+        const unsigned last_row = (k + rows < hi) ? k + rows : hi;
+        for (unsigned i = lo; i <= last_row; ++i)
+        {
+            Real dot = 0.0;
+            for (unsigned j = 0; j < rows; ++j)
+            {
+                dot += h(i, k+j) * w[j];
+            }
+
+            dot *= beta;
+            for (unsigned j = 0; j < rows; ++j)
+            {
+                h(i, k+j) -= dot * w[j];
+            }
+        }
+
+        if (k > lo)
+        {
+            h(k, k-1) = alpha;
+            for (unsigned i = 1; i < rows; ++i)
+            {
+                h(k+i, k-1) = 0.0;
+            }
+        }
+    }
+
+    ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    //! @brief Solve (H - mu*I)*y = b with partial pivoting restricted to adjacent rows (Hessenberg structure)
+    //!
+    //! Zero pivots are replaced by `eps`, as required by inverse iteration.
+    ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    RVector solve_shifted(Real mu, const RVector& b, Real eps) const
+    {
+        RMatrix m = m_hessenberg;
+        RVector y = b;
+
+        for (unsigned i = 1; i <= m_n; ++i)
+        {
+            m(i, i) -= mu;
+        }
+
+        for (unsigned k = 1; k < m_n; ++k)
+        {
+            if (std::abs(m(k+1, k)) > std::abs(m(k, k)))
+            {
+                for (unsigned j = k; j <= m_n; ++j)
+                {
+                    std::swap(m(k, j), m(k+1, j));
+                }
+                std::swap(y(k), y(k+1));
+            }
+
+            if (m(k, k) == 0.0)
+            {
+                m(k, k) = eps;
+            }
+
+            const Real factor = m(k+1, k) / m(k, k);
+            for (unsigned j = k; j <= m_n; ++j)
+            {
+                m(k+1, j) -= factor * m(k, j);
+            }
+            y(k+1) -= factor * y(k);
+        }
+
+        for (unsigned k = m_n; k > 0; --k)
+        {
+            if (m(k, k) == 0.0)
+            {
+                m(k, k) = eps;
+            }
+
+            for (unsigned j = k+1; j <= m_n; ++j)
+            {
+                y(k) -= m(k, j) * y(j);
+            }
+            y(k) /= m(k, k);
+        }
+
+        return y;
+    }
+
+    static constexpr unsigned max_iterations = 30;
+
+    const unsigned m_n;
+    RMatrix m_hessenberg;
+    RMatrix m_q;
+    std::vector<Real> m_real_parts;
+    std::vector<Real> m_imaginary_parts;
+};
+
+}
@@ -31,41 +31,66 @@ public:
 
     VectorType operator() (const VectorType& vec)
     {
-        const Eigenpair<MapT> pair = Eigenpair<MapT>::create(vec);
-        const VectorType& x = pair.get_vector();
-        const ScalarType& lambda = pair.get_lambda();
+        check_argument(vec);
 
-        const ScalarType vec_norm_sqr = capd::vectalg::scalarProduct(x, x);
-        const VectorType eigen_part = m_arg * x - lambda * x;
+        const ScalarType& lambda = vec[m_n];
 
-        return Concat<MapT>::concat_vectors({ eigen_part, VectorType{ vec_norm_sqr - 1.0 } });
+        VectorType ret(m_n + 1);
+        ScalarType vec_norm_sqr(0.0);
+
+        for (unsigned i = 1; i <= m_n; ++i)
+        {
+            ScalarType value = -lambda * vec(i);
+
+            for (unsigned j = 1; j <= m_n; ++j)
+            {
+                value += m_arg(i, j) * vec(j);
+            }
+
+            ret(i) = value;
+            vec_norm_sqr += vec(i) * vec(i);
+        }
+
+        ret(m_n + 1) = vec_norm_sqr - 1.0;
+        return ret;
     }
 
     VectorType operator() (const VectorType& vec, MatrixType& mat)
     {
-        const Eigenpair<MapT> pair = Eigenpair<MapT>::create(vec);
-        const VectorType& x = pair.get_vector();
-        const ScalarType& lambda = pair.get_lambda();
+        check_argument(vec);
 
-        const ScalarType vec_norm_sqr = capd::vectalg::scalarProduct(x, x);
+        const ScalarType& lambda = vec[m_n];
 
-        mat = MatrixType(m_n+1, m_n+1);
+        if (mat.numberOfRows() != m_n + 1 || mat.numberOfColumns() != m_n + 1)
+        {
+            mat = MatrixType(m_n + 1, m_n + 1);
+        }
 
-        const MatrixType der1 = m_arg - MatrixType::Identity(m_n) * lambda;
-        const VectorType eigen_part = der1 * x;
+        VectorType ret(m_n + 1);
+        ScalarType vec_norm_sqr(0.0);
 
         for (unsigned i = 1; i <= m_n; ++i)
         {
+            ScalarType value(0.0);
+
             for (unsigned j = 1; j <= m_n; ++j)
             {
-                mat(i, j) = der1(i, j);
+                mat(i, j) = m_arg(i, j);
+                value += m_arg(i, j) * vec(j);
             }
 
-            mat(i, m_n+1) = -x(i);
-            mat(m_n+1, i) = 2 * x(i);
+            mat(i, i) -= lambda;
+            mat(i, m_n+1) = -vec(i);
+            mat(m_n+1, i) = 2 * vec(i);
+
+            ret(i) = value - lambda * vec(i);
+            vec_norm_sqr += vec(i) * vec(i);
         }
 
-        return Concat<MapT>::concat_vectors({ eigen_part, VectorType{ vec_norm_sqr - 1.0 } });
+        mat(m_n+1, m_n+1) = ScalarType(0.0);
+
+        ret(m_n + 1) = vec_norm_sqr - 1.0;
+        return ret;
     }
 
     unsigned dimension() const noexcept
@@ -78,6 +103,11 @@ public:
         return m_n + 1;
     }
 
+    const MatrixType& get_matrix() const noexcept
+    {
+        return m_arg;
+    }
+
     static MatrixType create_eigenvalues_matrix(const std::list<Eigenpair<MapT>>& eigenpairs)
     {
         MatrixType ret( eigenpairs.size(), eigenpairs.size(), ScalarType(0.0) );
@@ -127,26 +157,13 @@ private:
         return arg.dimension().first;
     }
 
-    struct Arg
+    void check_argument(const VectorType& vec) const
     {
-        VectorType x;
-        ScalarType lambda;
-        ScalarType x_norm_squared;
-
-        Arg(const VectorType& vec)
-            : x( vec.dimension()-1 )
-            , lambda()
-            , x_norm_squared()
+        if (vec.dimension() != m_n + 1)
         {
-            for (unsigned i = 0; i < vec.dimension()-1; ++i)
-            {
-                x[i] = vec[i];
-                x_norm_squared += x[i] * x[i];
-            }
-
-            lambda = vec[vec.dimension()-1];
+            throw std::logic_error("Eigenproblem: unexpected argument dimension!");
         }
-    };
+    }
 
     const unsigned m_n;
     MatrixType m_arg;
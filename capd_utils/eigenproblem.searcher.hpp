@@ -4,14 +4,18 @@
 
 #pragma once
 
+#include <stdexcept>
+
 #include "eigenproblem.hpp"
+#include "eigenproblem.hessenberg_qr.hpp"
+#include "type_cast.hpp"
 #include <capd_utils/newton_method/newton_method.multisearcher.hpp>
 
 namespace CapdUtils
 {
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
-//! @brief Heuristic solver for eigenvalue problem
+//! @brief Solver for eigenvalue problem (heuristic multistart or deterministic HessenbergQR based)
 ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 template<typename MapT>
 class EigenproblemSearcher
@@ -77,7 +81,52 @@ public:
         return ret;
     }
 
+    ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    //! @brief Deterministic solver for eigenvalue problem
+    //!
+    //! @details Initial guesses of all real eigenpairs are computed by HessenbergQR for midpoint of the matrix, then
+    //!          each of them is refined (and validated for interval maps) by single Newton method run. Complex
+    //!          eigenvalues are omitted, because Eigenproblem is formulated over reals. Eigenpairs for which the
+    //!          refinement fails (singular derivative, i.e. std::runtime_error from the Gauss solver or interval
+    //!          arithmetic, or unsuccessful Newton method) are skipped.
+    ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    std::list<Eigenpair<MapT>> find_eigenpairs(size_t steps_per_pair)
+    {
+        const HessenbergQR solver( matrix_cast<RMatrix>(m_problem.get_matrix()) );
+
+        std::list<Eigenpair<MapT>> ret {};
+
+        for (Real lambda : solver.get_real_eigenvalues())
+        {
+            const Eigenpair<MapT> initial_eigenpair(
+                vector_cast<VectorType>( solver.get_eigenvector(lambda) ),
+                scalar_cast<ScalarType>( lambda ));
+
+            try
+            {
+                NewtonMethod<Eigenproblem<MapT>> newton_method(m_problem, get_initial_root(initial_eigenpair), steps_per_pair);
+
+                if (newton_method.is_successful())
+                {
+                    ret.emplace_back( Eigenpair<MapT>::create( newton_method.get_root() ) );
+                }
+            }
+            catch (const std::runtime_error&)
+            {}
+        }
+
+        return ret;
+    }
+
     Eigenpair<MapT> find_single_eigenpair(size_t steps, const Eigenpair<MapT>& initial_eigenpair)
+    {
+        NewtonMethod<decltype(m_problem)> m_internal_searcher(m_problem, get_initial_root(initial_eigenpair), steps);
+        const VectorType ret = m_internal_searcher.get_root();
+        return Eigenpair<MapT>::create( ret );
+    }
+
+private:
+    static VectorType get_initial_root(const Eigenpair<MapT>& initial_eigenpair)
     {
         const VectorType& x = initial_eigenpair.get_vector();
         const ScalarType& lambda = initial_eigenpair.get_lambda();
@@ -90,12 +139,9 @@ public:
         }
         initial_root[ x.dimension() ] = lambda;
 
-        NewtonMethod<decltype(m_problem)> m_internal_searcher(m_problem, initial_root, steps);
-        const VectorType ret = m_internal_searcher.get_root();
-        return Eigenpair<MapT>::create( ret );
+        return initial_root;
     }
 
-private:
     Eigenproblem<MapT> m_problem;
 };
 
@@ -10,6 +10,7 @@
 #include "map_compatibility.hpp"
 
 #include <stdexcept>
+#include <vector>
 
 namespace CapdUtils
 {
@@ -41,8 +42,8 @@ public:
         const IdxList<size_t>& out_idx_list,
         MapUArgs... map_u_args)
             : m_map_u(map_u_args...)
-            , m_extension(ExtensionMap<MapT>::create(extension_values, in_idx_list ))
-            , m_projection(ProjectionMap<MapT>::create(m_map_u.imageDimension(), out_idx_list))
+            , m_extension(extension_values, in_idx_list)
+            , m_projection(m_map_u.imageDimension(), out_idx_list)
     {
         if ( m_extension.imageDimension() != m_map_u.dimension() )
         {
@@ -70,19 +71,37 @@ public:
     {
         this->assert_vector_size(vec, m_extension.dimension(), "ENP vec vector size mismatch (2)!");
 
-        MatrixType m1(m_extension.imageDimension(), m_extension.dimension());
-        const VectorType v1 = m_extension(vec, m1);
-        this->assert_matrix_size(m1, m_extension.imageDimension(), m_extension.dimension(), "ENP m1 matrix size mismatch!");
+        const VectorType v1 = m_extension(vec);
 
         MatrixType m2(m_map_u.imageDimension(), m_map_u.dimension());
         const VectorType v2 = m_map_u(v1, m2);
         this->assert_matrix_size(m2, m_map_u.imageDimension(), m_map_u.dimension(), "ENP m2 matrix size mismatch!");
 
-        MatrixType m3(m_projection.imageDimension(), m_projection.dimension());
-        const VectorType v3 = m_projection(v2, m3);
-        this->assert_matrix_size(m3, m_projection.imageDimension(), m_projection.dimension(), "ENP m3 matrix size mismatch!");
+        const VectorType v3 = m_projection(v2);
+
+        // Derivatives of projection and extension are 0/1 matrices, so the product is computed by indices: row i of
+        // the result is row out_idx[i] of m2 with column r added to column in_idx[r] (r over non-extension values)
+        const IdxList<int>& in_idx = m_extension.indices();
+        const IdxList<size_t>& out_idx = m_projection.indices();
 
-        mat = m3 * m2 * m1;
+        assign_zero(mat, this->imageDimension(), this->dimension());
+
+        size_t i = 0;
+        for (const size_t& row : out_idx)
+        {
+            size_t r = 0;
+            for (const int& col : in_idx)
+            {
+                if (col >= 0)
+                {
+                    mat(i+1, col+1) += m2(row+1, r+1);
+                }
+
+                ++r;
+            }
+
+            ++i;
+        }
 
         return v3;
     }
@@ -98,13 +117,13 @@ public:
     }
 
     MapU & internal_map() noexcept { return m_map_u; }
-    MapT & extend() noexcept { return m_extension; }
-    MapT & project() noexcept { return m_projection; }
+    IndexExtensionMap<MapT> & extend() noexcept { return m_extension; }
+    IndexProjectionMap<MapT> & project() noexcept { return m_projection; }
 
 private:
     MapU m_map_u;
-    MapT m_extension;
-    MapT m_projection;
+    IndexExtensionMap<MapT> m_extension;
+    IndexProjectionMap<MapT> m_projection;
 };
 
 }
@@ -0,0 +1,71 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Author: Aleksander M. Pasiut
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <algorithm>
+#include <memory>
+#include <thread>
+
+#include "thread_pool.hpp"
+
+namespace CapdUtils
+{
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//! @brief Execution policy evaluating independent tasks one after another
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+class SequentialExecution
+{
+public:
+    template<typename FuncT>
+    void run(size_t tasks, FuncT&& func)
+    {
+        for (size_t i = 0; i < tasks; ++i)
+        {
+            func(i);
+        }
+    }
+};
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//! @brief Execution policy evaluating independent tasks concurrently on a thread pool
+//!
+//! Copies of the policy share the pool. Policies constructed with the default number of threads share single process-wide
+//! pool, so default constructed policies (e.g. default arguments) do not start new threads.
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+class ParallelExecution
+{
+public:
+    //! @param threads number of threads (0 means std::thread::hardware_concurrency() threads of the shared default pool)
+    explicit ParallelExecution(unsigned threads = 0)
+        : m_pool( threads > 0 ? std::make_shared<ThreadPool>(threads) : get_default_pool() )
+    {}
+
+    template<typename FuncT>
+    void run(size_t tasks, FuncT&& func)
+    {
+        if (tasks == 1 || m_pool->size() == 1)
+        {
+            SequentialExecution().run(tasks, func);
+        }
+        else
+        {
+            m_pool->run(tasks, func);
+        }
+    }
+
+private:
+    static std::shared_ptr<ThreadPool> get_default_pool()
+    {
+        static const std::shared_ptr<ThreadPool> pool =
+            std::make_shared<ThreadPool>( std::max(1u, std::thread::hardware_concurrency()) );
+
+        return pool;
+    }
+
+    std::shared_ptr<ThreadPool> m_pool;
+};
+
+}
@@ -4,11 +4,14 @@
 
 #pragma once
 
+#include <algorithm>
 #include <list>
 #include <stdexcept>
+#include <vector>
 
 #include "capd/basic_types.hpp"
 #include "idx_list.hpp"
+#include "map_base.hpp"
 
 namespace CapdUtils
 {
@@ -134,4 +137,204 @@ private:
     }
 };
 
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//! @brief Extension map evaluated by indices
+//!
+//! @details Equivalent of the map created by ExtensionMap::create without automatic differentiation: value is
+//!          scattered in O(k) for k outputs and the derivative is constant 0/1 matrix with at most single 1 in each row.
+//!          Extension values may be changed by `setParameter` as for CAPD maps. Indices are kept as runs of IdxList
+//!          and only the extension values are stored (none for zero extension), so the map takes constant memory for
+//!          zero extension with lists made by IdxList::create.
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+template<typename MapT>
+class IndexExtensionMap : public MapBase<MapT>
+{
+public:
+    using ScalarType = typename MapT::ScalarType;
+    using VectorType = typename MapT::VectorType;
+    using MatrixType = typename MapT::MatrixType;
+
+    ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    //! @brief Constructor
+    //!
+    //! @param values   extension values specifying outputs (see ExtensionMap::create)
+    //! @param idx_list indices specifying output source
+    ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    IndexExtensionMap(const VectorType& values, const IdxList<int>& idx_list) : IndexExtensionMap(idx_list)
+    {
+        if (values.dimension() != m_idx.size())
+        {
+            throw std::logic_error("Values vector and index list size mismatch!");
+        }
+
+        m_values.reserve(m_extension_size);
+
+        size_t r = 0;
+        for (const Run& run : m_idx.runs())
+        {
+            const size_t extension = get_extension_size(run);
+            for (size_t k = 0; k < extension; ++k)
+            {
+                m_values.push_back(values[r+k]);
+            }
+
+            r += run.length;
+        }
+    }
+
+    ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    //! @brief Constructor
+    //!
+    //! Simplified version for zero extension vector.
+    ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    explicit IndexExtensionMap(const IdxList<int>& idx_list)
+        : m_idx(idx_list)
+        , m_input_size( get_input_size(idx_list) )
+        , m_extension_size( get_extension_size(idx_list) )
+    {
+        if (m_idx.empty())
+        {
+            throw std::logic_error("Index list is empty!");
+        }
+    }
+
+    VectorType operator() (const VectorType& vec) override
+    {
+        this->assert_vector_size(vec, m_input_size, "IndexExtensionMap vec vector size mismatch (1)!");
+
+        VectorType ret( m_idx.size() );
+
+        size_t r = 0;
+        size_t value_idx = 0;
+        for (const Run& run : m_idx.runs())
+        {
+            const size_t extension = get_extension_size(run);
+            for (size_t k = 0; k < extension; ++k, ++r, ++value_idx)
+            {
+                if (!m_values.empty())
+                {
+                    ret[r] = m_values[value_idx];
+                }
+            }
+
+            for (size_t k = extension; k < run.length; ++k, ++r)
+            {
+                ret[r] = vec[run.first + static_cast<int>(k) * run.step];
+            }
+        }
+
+        return ret;
+    }
+
+    VectorType operator() (const VectorType& vec, MatrixType& mat) override
+    {
+        assign_zero(mat, this->imageDimension(), this->dimension());
+
+        size_t r = 0;
+        for (const Run& run : m_idx.runs())
+        {
+            for (size_t k = get_extension_size(run); k < run.length; ++k)
+            {
+                mat(r+k+1, run.first + static_cast<int>(k) * run.step + 1) = 1.0;
+            }
+
+            r += run.length;
+        }
+
+        return (*this)(vec);
+    }
+
+    unsigned dimension() const noexcept override
+    {
+        return m_input_size;
+    }
+
+    unsigned imageDimension() const noexcept override
+    {
+        return m_idx.size();
+    }
+
+    JacobianStructure jacobian_structure() const noexcept override
+    {
+        return JacobianStructure::Sparse;
+    }
+
+    //! Set extension value of i-th output (ignored for outputs taken from the input)
+    void setParameter(unsigned i, const ScalarType& value)
+    {
+        size_t r = 0;
+        size_t value_idx = 0;
+        for (const Run& run : m_idx.runs())
+        {
+            const size_t extension = get_extension_size(run);
+            if (i < r + run.length)
+            {
+                if (i < r + extension)
+                {
+                    if (m_values.empty())
+                    {
+                        m_values.assign(m_extension_size, ScalarType(0.0));
+                    }
+
+                    m_values[value_idx + (i - r)] = value;
+                }
+
+                return;
+            }
+
+            r += run.length;
+            value_idx += extension;
+        }
+    }
+
+    //! Input index of each output (-1 for extension values)
+    const IdxList<int>& indices() const noexcept
+    {
+        return m_idx;
+    }
+
+private:
+    using Run = typename IdxList<int>::Run;
+
+    //! Number of extension outputs in the run (indices in runs are non-decreasing, so negative ones come first)
+    static size_t get_extension_size(const Run& run)
+    {
+        if (run.first >= 0)
+        {
+            return 0;
+        }
+
+        return run.step > 0 ? std::min<size_t>(run.length, (run.step - 1 - run.first) / run.step) : run.length;
+    }
+
+    static size_t get_extension_size(const IdxList<int>& idx_list)
+    {
+        size_t ret = 0;
+        for (const Run& run : idx_list.runs())
+        {
+            ret += get_extension_size(run);
+        }
+
+        return ret;
+    }
+
+    static size_t get_input_size(const IdxList<int>& idx_list)
+    {
+        int ret = 0;
+        for (const Run& run : idx_list.runs())
+        {
+            ret = std::max(ret, run.first + static_cast<int>(run.length - 1) * run.step + 1);
+        }
+
+        return ret;
+    }
+
+    IdxList<int> m_idx;
+    size_t m_input_size;
+    size_t m_extension_size;
+
+    //! Values of extension outputs in order (empty for zero extension)
+    std::vector<ScalarType> m_values {};
+};
+
 }
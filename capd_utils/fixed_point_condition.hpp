@@ -40,14 +40,16 @@ public:
     {
         const size_t N = m_map_u.dimension();
 
-        MatrixType m2(N, N);
-        const VectorType v2 = m_id(vec, m2);
+        mat = MatrixType(N, N);
+        const VectorType v1 = m_map_u(vec, mat);
 
-        MatrixType m1(N, N);
-        const VectorType v1 = m_map_u(vec, m1);
+        // derivative of the identity is subtracted in place
+        for (size_t i = 1; i <= N; ++i)
+        {
+            mat(i, i) -= 1.0;
+        }
 
-        mat = m1 - m2;
-        return v1 - v2;
+        return v1 - m_id(vec);
     }
 
     int dimension() const noexcept
@@ -4,61 +4,274 @@
 
 #pragma once
 
+#include <cmath>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include <capd_utils/capd/basic_tools.hpp>
 #include <capd_utils/capd/gauss_solver.hpp>
 
 namespace CapdUtils
 {
 
+namespace GaussInternal
+{
+
+template<typename ScalarType, bool is_interval>
+struct Pivoting
+{};
+
+template<typename ScalarType>
+struct Pivoting<ScalarType, true>
+{
+    using BoundType = typename ScalarType::BoundType;
+
+    //! Mignitude of the interval (pivot must not contain zero)
+    static BoundType magnitude(const ScalarType& arg)
+    {
+        return abs(arg).leftBound();
+    }
+
+    //! Point approximation of inverse of mid(A) used as preconditioner
+    template<typename MapT>
+    static typename MapT::MatrixType preconditioner(const typename MapT::MatrixType& A)
+    {
+        return mid_matrix( gaussInverseMatrix<MapT>( mid_matrix(A) ) );
+    }
+
+    template<typename MatrixType>
+    static MatrixType precondition(const MatrixType& C, const MatrixType& arg)
+    {
+        return C * arg;
+    }
+};
+
+template<typename ScalarType>
+struct Pivoting<ScalarType, false>
+{
+    static ScalarType magnitude(const ScalarType& arg)
+    {
+        using std::abs;
+        return abs(arg);
+    }
+
+    //! Point computation is not preconditioned
+    template<typename MapT>
+    static typename MapT::MatrixType preconditioner(const typename MapT::MatrixType&)
+    {
+        return typename MapT::MatrixType();
+    }
+
+    template<typename MatrixType>
+    static MatrixType precondition(const MatrixType&, const MatrixType& arg)
+    {
+        return arg;
+    }
+};
+
+}
+
 ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
-//! @brief Solve equation of the form A * X = B with respect to X, where A, X and B are matrices.
-//! @details Implemented by performing gauss elimination for respective columns.
+//! @brief Solver of equations of the form A * X = B with respect to X, where A, X and B are matrices.
+//!
+//! @details A is factorized once (LU with partial pivoting), so each solve costs O(n^2) per column of B. For interval
+//!          computation A is preconditioned by point approximation C of its inverse, i.e. C*A = L*U and X solves
+//!          L*U*X = C*B.
 ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 template<typename MapT>
-typename MapT::MatrixType gaussMatrixSolver(
-    const typename MapT::MatrixType& A,
-    const typename MapT::MatrixType& B)
+class GaussMatrixSolver
 {
+public:
+    using ScalarType = typename MapT::ScalarType;
     using VectorType = typename MapT::VectorType;
     using MatrixType = typename MapT::MatrixType;
 
-    MatrixType ret(B.dimension());
+    GaussMatrixSolver(const MatrixType& A)
+        : m_n(get_dimension(A))
+        , m_preconditioner( Pivoting::template preconditioner<MapT>(A) )
+        , m_lu( Pivoting::precondition(m_preconditioner, A) )
+        , m_permutation(m_n + 1)
+    {
+        factorize();
+    }
 
-    for (int j = 0; j < ret.numberOfColumns(); ++j)
+    MatrixType solve(const MatrixType& B) const
     {
-        VectorType column(ret.numberOfRows());
-        for (int i = 0; i < ret.numberOfRows(); ++i)
+        if (B.numberOfRows() != m_n)
+        {
+            throw std::logic_error("GaussMatrixSolver: right hand side dimension mismatch!");
+        }
+
+        const MatrixType rhs = Pivoting::precondition(m_preconditioner, B);
+        const unsigned m = B.numberOfColumns();
+
+        MatrixType ret(m_n, m);
+
+        for (unsigned i = 1; i <= m_n; ++i)
         {
-            column[i] = B(i+1, j+1);
+            for (unsigned c = 1; c <= m; ++c)
+            {
+                ret(i, c) = rhs(m_permutation[i], c);
+            }
         }
 
-        const VectorType solution = gauss<MapT>(A, column);
-        for (int i = 0; i < ret.numberOfRows(); ++i)
+        for (unsigned k = 1; k <= m_n; ++k)
         {
-            ret(i+1, j+1) = solution[i];
+            for (unsigned i = k+1; i <= m_n; ++i)
+            {
+                for (unsigned c = 1; c <= m; ++c)
+                {
+                    ret(i, c) -= m_lu(i, k) * ret(k, c);
+                }
+            }
         }
+
+        for (unsigned i = m_n; i > 0; --i)
+        {
+            for (unsigned c = 1; c <= m; ++c)
+            {
+                ScalarType value = ret(i, c);
+
+                for (unsigned l = i+1; l <= m_n; ++l)
+                {
+                    value -= m_lu(i, l) * ret(l, c);
+                }
+
+                ret(i, c) = value / m_lu(i, i);
+            }
+        }
+
+        return ret;
     }
 
-    return ret;
+    VectorType solve(const VectorType& b) const
+    {
+        MatrixType rhs(b.dimension(), 1);
+        for (unsigned i = 1; i <= b.dimension(); ++i)
+        {
+            rhs(i, 1) = b(i);
+        }
+
+        const MatrixType solution = solve(rhs);
+
+        VectorType ret(m_n);
+        for (unsigned i = 1; i <= m_n; ++i)
+        {
+            ret(i) = solution(i, 1);
+        }
+
+        return ret;
+    }
+
+private:
+    using Pivoting = GaussInternal::Pivoting<ScalarType, capd::TypeTraits<ScalarType>::isInterval>;
+
+    static unsigned get_dimension(const MatrixType& A)
+    {
+        if (A.numberOfRows() != A.numberOfColumns())
+        {
+            throw std::logic_error("GaussMatrixSolver is implemented for square matrices only!");
+        }
+
+        return A.numberOfRows();
+    }
+
+    void factorize()
+    {
+        for (unsigned i = 1; i <= m_n; ++i)
+        {
+            m_permutation[i] = i;
+        }
+
+        for (unsigned k = 1; k <= m_n; ++k)
+        {
+            unsigned pivot = k;
+            for (unsigned i = k+1; i <= m_n; ++i)
+            {
+                if (Pivoting::magnitude(m_lu(i, k)) > Pivoting::magnitude(m_lu(pivot, k)))
+                {
+                    pivot = i;
+                }
+            }
+
+            if (!(Pivoting::magnitude(m_lu(pivot, k)) > 0))
+            {
+                throw std::runtime_error("GaussMatrixSolver: matrix is singular!");
+            }
+
+            if (pivot != k)
+            {
+                for (unsigned j = 1; j <= m_n; ++j)
+                {
+                    std::swap(m_lu(k, j), m_lu(pivot, j));
+                }
+                std::swap(m_permutation[k], m_permutation[pivot]);
+            }
+
+            for (unsigned i = k+1; i <= m_n; ++i)
+            {
+                const ScalarType factor = m_lu(i, k) / m_lu(k, k);
+
+                for (unsigned j = k+1; j <= m_n; ++j)
+                {
+                    m_lu(i, j) -= factor * m_lu(k, j);
+                }
+
+                m_lu(i, k) = factor;
+            }
+        }
+    }
+
+    const unsigned m_n;
+    const MatrixType m_preconditioner;
+    MatrixType m_lu;
+    std::vector<unsigned> m_permutation;
+};
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//! @brief Solve equation of the form A * X = B with respect to X, where A, X and B are matrices.
+//! @details Implemented by single factorization of A shared by all columns of B (see GaussMatrixSolver).
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+template<typename MapT>
+typename MapT::MatrixType gaussMatrixSolver(
+    const typename MapT::MatrixType& A,
+    const typename MapT::MatrixType& B)
+{
+    return GaussMatrixSolver<MapT>(A).solve(B);
 }
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 //! @brief Solve equation of the form A * X = B with respect to X, where A, X and B are matrices.
-//! @details This implementation is valid for interval computation only!
-//! @return The intersection of the solution obtained from the multiplication by the matrix inverse and with gaussMatrixSolver.
+//! @details Variant of gaussMatrixSolverWithIntersect with precomputed factorization and enclosure of inverse of A.
 ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 template<typename MapT>
 typename MapT::MatrixType gaussMatrixSolverWithIntersect(
-    const typename MapT::MatrixType& A,
+    const GaussMatrixSolver<MapT>& A_solver,
+    const typename MapT::MatrixType& A_inverse,
     const typename MapT::MatrixType& B)
 {
     using MatrixType = typename MapT::MatrixType;
 
-    const MatrixType ret_1 = gaussInverseMatrix<MapT>(A) * B;
-    const MatrixType ret_2 = gaussMatrixSolver<MapT>(A, B);
+    const MatrixType ret_1 = A_inverse * B;
+    const MatrixType ret_2 = A_solver.solve(B);
 
     MatrixType ret( ret_1.dimension() );
     capd::vectalg::intersection(ret_1.begin(), ret_2.begin(), ret.begin(), ret.end());
     return ret;
 }
 
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//! @brief Solve equation of the form A * X = B with respect to X, where A, X and B are matrices.
+//! @details This implementation is valid for interval computation only!
+//! @return The intersection of the solution obtained from the multiplication by the matrix inverse and with gaussMatrixSolver.
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+template<typename MapT>
+typename MapT::MatrixType gaussMatrixSolverWithIntersect(
+    const typename MapT::MatrixType& A,
+    const typename MapT::MatrixType& B)
+{
+    return gaussMatrixSolverWithIntersect<MapT>(GaussMatrixSolver<MapT>(A), gaussInverseMatrix<MapT>(A), B);
+}
+
 }
@@ -4,8 +4,13 @@
 
 #pragma once
 
+#include <list>
+#include <stdexcept>
+#include <vector>
+
 #include <capd_utils/capd/map.hpp>
 #include <capd_utils/concat.hpp>
+#include <capd_utils/execution_policy.hpp>
 
 namespace CapdUtils
 {
@@ -24,6 +29,15 @@ public:
     using MatrixType = typename MapT::MatrixType;
 
     static std::list<VectorType> gen_vectors(const VectorType& v1, const VectorType& v2)
+    {
+        const std::vector<VectorType> basis = gen_basis(v1, v2);
+        return std::list<VectorType>(basis.begin(), basis.end());
+    }
+
+    ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    //! @brief Same as gen_vectors, orthogonalized by modified Gram-Schmidt in contiguous storage
+    ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    static std::vector<VectorType> gen_basis(const VectorType& v1, const VectorType& v2)
     {
         if (v1.dimension() == v2.dimension())
         {
@@ -33,26 +47,25 @@ public:
             unsigned const idx_1 = find_max_index(u1);
             unsigned const idx_2 = find_max_index(u2, idx_1);
 
-            std::list<VectorType> vecs = gen_init_vectors(v1.dimension(), idx_1, idx_2);
-            vecs.push_front(u2 / u2.euclNorm());
-            vecs.push_front(u1 / u1.euclNorm());
+            std::vector<VectorType> ret {};
+            ret.reserve(v1.dimension());
 
-            std::list<VectorType> ret {};
-            for (VectorType vec : vecs)
+            ret.push_back(u1);
+            ret.push_back(u2);
+            append_init_vectors(ret, v1.dimension(), idx_1, idx_2);
+
+            for (size_t k = 0; k < ret.size(); ++k)
             {
-                for (const VectorType& v : ret)
+                ret[k] /= ret[k].euclNorm();
+
+                for (size_t j = k + 1; j < ret.size(); ++j)
                 {
-                    vec -= capd::vectalg::scalarProduct(vec, v) * v;
+                    ret[j] -= capd::vectalg::scalarProduct(ret[j], ret[k]) * ret[k];
                 }
-                vec /= vec.euclNorm();
-                ret.push_back(vec);
             }
 
-            ret.pop_front();
-            ret.pop_front();
-
-            ret.push_front(v2 / v2.euclNorm());
-            ret.push_front(v1 / v1.euclNorm());
+            ret[0] = v1 / v1.euclNorm();
+            ret[1] = v2 / v2.euclNorm();
 
             return ret;
         }
@@ -62,6 +75,29 @@ public:
         }
     }
 
+    ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    //! @brief Generate bases for all pairs of `v1_list` and `v2_list` (e.g. for all shooting nodes) according to PolicyT
+    ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    template<typename PolicyT = SequentialExecution>
+    static std::vector<std::vector<VectorType>> gen_bases(const std::vector<VectorType>& v1_list,
+                                                          const std::vector<VectorType>& v2_list,
+                                                          PolicyT policy = PolicyT())
+    {
+        if (v1_list.size() != v2_list.size())
+        {
+            throw std::logic_error("GGS: number of v1 and v2 vectors mismatch!");
+        }
+
+        std::vector<std::vector<VectorType>> ret(v1_list.size());
+
+        policy.run(v1_list.size(), [&](size_t i)
+        {
+            ret[i] = gen_basis(v1_list[i], v2_list[i]);
+        });
+
+        return ret;
+    }
+
 private:
     static unsigned find_max_index(const VectorType& v)
     {
@@ -106,18 +142,15 @@ private:
         return ret;
     }
 
-    static std::list<VectorType> gen_init_vectors(unsigned dimension, unsigned idx_1, unsigned idx_2)
+    static void append_init_vectors(std::vector<VectorType>& vecs, unsigned dimension, unsigned idx_1, unsigned idx_2)
     {
-        std::list<VectorType> ret {};
         for (unsigned i = 0; i < dimension; ++i)
         {
             if (i != idx_1 && i != idx_2)
             {
-                ret.push_back(gen_init_vector(dimension, i));
+                vecs.push_back(gen_init_vector(dimension, i));
             }
         }
-
-        return ret;
     }
 
     ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -5,11 +5,16 @@
 #pragma once
 
 #include <list>
+#include <string>
+#include <type_traits>
+#include <utility>
 #include <vector>
 #include <stdexcept>
 
+#include "capd/basic_tools.hpp"
 #include "capd/basic_types.hpp"
 #include "map_base.hpp"
+#include "checkpoint.hpp"
 
 #ifdef CAPD_UTILS_LOG
 #include "progress_logger.hpp"
@@ -18,6 +23,13 @@
 namespace CapdUtils
 {
 
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//! @brief Map evaluated as the hull of its images of grid sub-boxes of the argument
+//!
+//! @details Sub-boxes are evaluated in a single batch only by maps providing evaluate_batch, i.e. GridMap<C1_Map<...>>
+//!          without checkpoint, where the batch is split between the workers of C1_Map. Other maps (e.g. GridMap<IMap>)
+//!          are evaluated box by box in the calling thread.
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 template<typename MapT>
 class GridMap : public MapBase<MapT>
 {
@@ -28,24 +40,58 @@ public:
 
     using BoundType = typename ScalarType::BoundType;
 
-    GridMap(MapT& ref, const std::vector<int>& grid) : m_ref(ref), m_grid(grid)
+    GridMap(MapT& ref, const std::vector<int>& grid) : m_ref(ref), m_grid(grid), m_checkpoint(nullptr)
+    {}
+
+    ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    //! @brief Constructor with checkpointing
+    //!
+    //! The number of processed boxes and the partial hull are saved into `checkpoint` during the evaluation. If
+    //! `checkpoint` contains state of the evaluation for the same argument, grid, scalar type and map (identified by its
+    //! value at the midpoint of the argument), the evaluation is resumed. The checkpoint is removed when the hull is
+    //! complete.
+    //!
+    //! Each save writes the whole partial hull (the vector, and the matrix for the derivative), so for fine grids
+    //! `checkpoint` should be created with period of many boxes, e.g. Checkpoint(path, 100).
+    ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    GridMap(MapT& ref, const std::vector<int>& grid, Checkpoint& checkpoint) : m_ref(ref), m_grid(grid), m_checkpoint(&checkpoint)
     {}
 
     VectorType operator() (const VectorType& vec)
     {
         const std::list<VectorType> args = split_vector(vec, m_grid);
 
+        if constexpr (HasBatchEvaluation<MapT>::value)
+        {
+            if (m_checkpoint == nullptr && args.size() > 0)
+            {
+                return evaluate_batch(args);
+            }
+        }
+
         if (args.size() > 0)
         {
             auto it = args.begin();
 
-            VectorType ret = m_ref(*it);
+            size_t index = 0;
+            VectorType ret {};
+            MatrixType dummy {};
+
+            const VectorType map_value = get_map_value(vec);
+
+            if (load_checkpoint(checkpoint_tag_value, vec, map_value, index, ret, dummy) == false)
+            {
+                ret = m_ref(*it);
+                index = 1;
+            }
+
+            std::advance(it, index);
 
             #ifdef CAPD_UTILS_LOG
-            ProgressLogger logger(std::cout, "Grid", args.size(), 1);
+            ProgressLogger logger(std::cout, "Grid", args.size(), index);
             #endif
 
-            for (++it; it != args.end(); ++it)
+            for (; it != args.end(); ++it)
             {
                 #ifdef CAPD_UTILS_LOG
                 ProgressLogger::Updater updater(logger);
@@ -54,8 +100,12 @@ public:
                 const VectorType img = m_ref(*it);
 
                 capd::vectalg::intervalHull(ret, img, ret);
+
+                ++index;
+                update_checkpoint(checkpoint_tag_value, vec, map_value, index, ret, dummy);
             }
 
+            remove_checkpoint();
             return ret;
         }
         else
@@ -72,13 +122,24 @@ public:
         {
             auto it = args.begin();
 
-            VectorType ret = m_ref(*it, mat);
+            size_t index = 0;
+            VectorType ret {};
+
+            const VectorType map_value = get_map_value(vec);
+
+            if (load_checkpoint(checkpoint_tag_derivative, vec, map_value, index, ret, mat) == false)
+            {
+                ret = m_ref(*it, mat);
+                index = 1;
+            }
+
+            std::advance(it, index);
 
             #ifdef CAPD_UTILS_LOG
-            ProgressLogger logger(std::cout, "Grid", args.size(), 1);
+            ProgressLogger logger(std::cout, "Grid", args.size(), index);
             #endif
 
-            for (++it; it != args.end(); ++it)
+            for (; it != args.end(); ++it)
             {
                 #ifdef CAPD_UTILS_LOG
                 ProgressLogger::Updater updater(logger);
@@ -90,8 +151,12 @@ public:
 
                 capd::vectalg::intervalHull(ret, img, ret);
                 capd::vectalg::intervalHull(mat, der, mat);
+
+                ++index;
+                update_checkpoint(checkpoint_tag_derivative, vec, map_value, index, ret, mat);
             }
 
+            remove_checkpoint();
             return ret;
         }
         else
@@ -120,7 +185,132 @@ public:
         return m_grid;
     }
 
+    ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    //! @brief Split vector `arg` into boxes of the grid
+    ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    static std::list<VectorType> split(const VectorType& arg, const std::vector<int>& grid)
+    {
+        return split_vector(arg, grid);
+    }
+
 private:
+    ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    //! @brief Check if MapU evaluates batches of boxes, i.e. provides evaluate_batch(std::vector<VectorType>) (see C1_Map)
+    ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    template<typename MapU, typename = void>
+    struct HasBatchEvaluation : std::false_type
+    {};
+
+    template<typename MapU>
+    struct HasBatchEvaluation<MapU, decltype(void( std::declval<MapU&>().evaluate_batch(
+        std::declval<const std::vector<typename MapU::VectorType>&>() ) ))> : std::true_type
+    {};
+
+    VectorType evaluate_batch(const std::list<VectorType>& args)
+    {
+        const std::vector<VectorType> images = m_ref.evaluate_batch( std::vector<VectorType>(args.begin(), args.end()) );
+
+        VectorType ret = images.front();
+        for (const VectorType& img : images)
+        {
+            capd::vectalg::intervalHull(ret, img, ret);
+        }
+
+        return ret;
+    }
+
+    static constexpr const char* checkpoint_tag_value = "GridMap.value";
+    static constexpr const char* checkpoint_tag_derivative = "GridMap.derivative";
+
+    //! Tag of the checkpoint containing the scalar kind of MapT (see BinaryScalarCodec)
+    static std::string checkpoint_tag(const char* tag)
+    {
+        return std::string(tag) + "/" + std::to_string(BinaryScalarCodec<ScalarType>::kind);
+    }
+
+    //! Value of the map at the midpoint of `vec` identifying the map in the checkpoint (evaluated only if checkpointing)
+    VectorType get_map_value(const VectorType& vec)
+    {
+        return m_checkpoint ? m_ref(mid_vector(vec)) : VectorType();
+    }
+
+    ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    //! @brief Load number of processed boxes and partial hulls if checkpoint of evaluation for `vec` is available
+    ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    bool load_checkpoint(const char* tag, const VectorType& vec, const VectorType& map_value,
+                         size_t& index, VectorType& ret, MatrixType& mat)
+    {
+        if (m_checkpoint)
+        {
+            return m_checkpoint->load(checkpoint_tag(tag), [&](CheckpointReader& reader) -> bool
+            {
+                const VectorType file_vec = reader.read_vector<MapT>();
+                const VectorType file_map_value = reader.read_vector<MapT>();
+
+                if (file_vec == vec && file_map_value == map_value && reader.read_index() == m_grid.size())
+                {
+                    for (int g : m_grid)
+                    {
+                        if (reader.read_index() != static_cast<std::uint64_t>(g))
+                        {
+                            return false;
+                        }
+                    }
+
+                    index = reader.read_index();
+                    ret = reader.read_vector<MapT>();
+                    mat = reader.read_matrix<MapT>();
+                    return true;
+                }
+                else
+                {
+                    return false;
+                }
+            });
+        }
+        else
+        {
+            return false;
+        }
+    }
+
+    ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    //! @brief Save number of processed boxes and partial hulls of evaluation for `vec`
+    ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    void update_checkpoint(const char* tag, const VectorType& vec, const VectorType& map_value,
+                           size_t index, const VectorType& ret, const MatrixType& mat)
+    {
+        if (m_checkpoint)
+        {
+            m_checkpoint->update(checkpoint_tag(tag), [&](CheckpointWriter& writer)
+            {
+                writer.write_vector<MapT>(vec);
+                writer.write_vector<MapT>(map_value);
+                writer.write_index(m_grid.size());
+
+                for (int g : m_grid)
+                {
+                    writer.write_index(g);
+                }
+
+                writer.write_index(index);
+                writer.write_vector<MapT>(ret);
+                writer.write_matrix<MapT>(mat);
+            });
+        }
+    }
+
+    ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    //! @brief Remove checkpoint of completed evaluation, so it is never loaded as the result of other evaluation
+    ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    void remove_checkpoint()
+    {
+        if (m_checkpoint)
+        {
+            m_checkpoint->remove();
+        }
+    }
+
     ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
     //! @brief Split vector `arg` by splitting it elements into counts determined by `grid`
     ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -233,6 +423,8 @@ private:
     MapT& m_ref;
 
     std::vector<int> m_grid;
+
+    Checkpoint* m_checkpoint;
 };
 
 }
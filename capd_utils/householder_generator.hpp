@@ -4,16 +4,22 @@
 
 #pragma once
 
-#include <tuple>
+#include <stdexcept>
+#include <vector>
 
 #include <capd_utils/capd/map.hpp>
 #include <capd_utils/concat.hpp>
+#include <capd_utils/execution_policy.hpp>
 
 namespace CapdUtils
 {
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 //! @brief Generate matrix of orthonormal basis where the direction of the first vector is specified
+//!
+//! @details The reflection H = s (I - 2ww^T/(w.w)) is stored implicitly by w and s = +-1, so H is applied to a vector
+//!          (`apply`) or a single vector of the basis is generated (`get_column`) in O(n). The explicit matrix is formed
+//!          only by `get_matrix`.
 ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 template<typename MapT>
 class HouseholderGenerator
@@ -23,74 +29,131 @@ public:
     using VectorType = typename MapT::VectorType;
     using MatrixType = typename MapT::MatrixType;
 
-    HouseholderGenerator(VectorType initial_vector)
-        : m_matrix( gen_matrix( gen_data( initial_vector )) )
+    HouseholderGenerator(const VectorType& initial_vector)
+        : m_w( gen_w(initial_vector) )
+        , m_negative( !(initial_vector[0] < 0.0) )
+        , m_factor( 2 / capd::vectalg::scalarProduct(m_w, m_w) )
     {}
 
-    const MatrixType& get_matrix() const
-    {
-        return m_matrix;
-    }
-
-private:
-    static std::tuple<VectorType, bool> gen_data(const VectorType v)
+    ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    //! @brief Replace `vec` by H * vec
+    ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    void apply_in_place(VectorType& vec) const
     {
-        if (v.dimension() == 0)
+        if (vec.dimension() != m_w.dimension())
         {
-            throw std::logic_error("Dimension of v must not be 0!");
+            throw std::logic_error("HouseholderGenerator vector dimension mismatch!");
         }
 
-        const VectorType e1 = gen_e_vector(v.dimension(), 0);
-        const ScalarType v_norm = v.euclNorm();
+        const ScalarType c = m_factor * capd::vectalg::scalarProduct(m_w, vec);
 
-        if (v[0] < 0.0)
+        for (unsigned i = 0; i < vec.dimension(); ++i)
         {
-            VectorType ret = v - e1 * v_norm;
-            return std::make_tuple(ret, false);
-        }
-        else
-        {
-            VectorType ret = v + e1 * v_norm;
-            return std::make_tuple(ret, true);
+            vec[i] -= c * m_w[i];
+
+            if (m_negative)
+            {
+                vec[i] = -vec[i];
+            }
         }
     }
 
-    static MatrixType gen_matrix(std::tuple<VectorType, bool> data)
+    VectorType apply(const VectorType& vec) const
     {
-        const VectorType w = std::get<0>(data);
-        const bool negative = std::get<1>(data);
-
-        MatrixType ret = MatrixType::Identity(w.dimension());
+        VectorType ret = vec;
+        apply_in_place(ret);
+        return ret;
+    }
 
-        const ScalarType factor = 2 / capd::vectalg::scalarProduct(w, w);
+    ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    //! @brief Vector of the basis of index `idx` (i.e. column of the matrix)
+    ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    VectorType get_column(unsigned idx) const
+    {
+        const ScalarType c = m_factor * m_w[idx];
 
-        for (int i = 1; i <= w.dimension(); ++i)
+        VectorType ret(m_w.dimension());
+        for (unsigned i = 0; i < ret.dimension(); ++i)
         {
-            for (int j = 1; j <= w.dimension(); ++j)
+            ret[i] = (i == idx) ? ScalarType(1.0) - c * m_w[i] : -c * m_w[i];
+
+            if (m_negative)
             {
-                ret(i,j) -= factor * w(i) * w(j);
+                ret[i] = -ret[i];
             }
         }
 
-        if (negative)
+        return ret;
+    }
+
+    MatrixType get_matrix() const
+    {
+        const unsigned n = m_w.dimension();
+
+        MatrixType ret(n, n);
+        for (unsigned i = 1; i <= n; ++i)
         {
-            ret *= -1.0;
+            for (unsigned j = 1; j <= n; ++j)
+            {
+                ret(i,j) = (i == j) ? ScalarType(1.0) - m_factor * m_w(i) * m_w(j) : -m_factor * m_w(i) * m_w(j);
+
+                if (m_negative)
+                {
+                    ret(i,j) = -ret(i,j);
+                }
+            }
         }
 
         return ret;
     }
 
+    unsigned dimension() const noexcept
+    {
+        return m_w.dimension();
+    }
+
     ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
-    //! @brief Generate vector of `dimension` with one in element of index `idx` and zeros otherwise
+    //! @brief Generate matrices for all `initial_vectors` (e.g. for all nodes of shooting map) according to PolicyT
     ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
-    static VectorType gen_e_vector(unsigned dimension, unsigned idx)
+    template<typename PolicyT = SequentialExecution>
+    static std::vector<MatrixType> gen_matrices(const std::vector<VectorType>& initial_vectors, PolicyT policy = PolicyT())
+    {
+        std::vector<MatrixType> ret(initial_vectors.size());
+
+        policy.run(initial_vectors.size(), [&](size_t i)
+        {
+            ret[i] = HouseholderGenerator(initial_vectors[i]).get_matrix();
+        });
+
+        return ret;
+    }
+
+private:
+    static VectorType gen_w(const VectorType& v)
     {
-        VectorType ret(dimension);
-        ret[idx] = 1.0;
+        if (v.dimension() == 0)
+        {
+            throw std::logic_error("Dimension of v must not be 0!");
+        }
+
+        const ScalarType v_norm = v.euclNorm();
+
+        VectorType ret = v;
+        if (v[0] < 0.0)
+        {
+            ret[0] -= v_norm;
+        }
+        else
+        {
+            ret[0] += v_norm;
+        }
+
         return ret;
     }
 
-    const MatrixType m_matrix;
+    VectorType m_w;
+    bool m_negative;
+    ScalarType m_factor;
 };
 
 }
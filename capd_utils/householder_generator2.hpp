@@ -4,8 +4,13 @@
 
 #pragma once
 
+#include <stdexcept>
+#include <vector>
+
 #include <capd_utils/householder_generator.hpp>
-#include <capd_utils/projection_map.hpp>
+#include <capd_utils/concat.hpp>
+#include <capd_utils/extract.hpp>
+#include <capd_utils/execution_policy.hpp>
 
 namespace CapdUtils
 {
@@ -13,8 +18,11 @@ namespace CapdUtils
 ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 //! @brief Generate matrix of orthonormal basis where the directions of the first two vectors are specified
 //!
-//! @details Direction of the first vector is taken directly from `initial_vector`. Direction of the second vector is 
+//! @details Direction of the first vector is taken directly from `initial_vector`. Direction of the second vector is
 //!          projection of `projected_vector` on hyperplane defined by `initial_vector`.
+//!
+//!          The matrix is the product H_v diag(1, H_u) of two reflections stored implicitly (see HouseholderGenerator),
+//!          so it is applied to a vector in O(n) and formed explicitly column by column in O(n^2).
 ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 template<typename MapT>
 class HouseholderGenerator2
@@ -24,51 +32,111 @@ public:
     using VectorType = typename MapT::VectorType;
     using MatrixType = typename MapT::MatrixType;
 
-    HouseholderGenerator2(VectorType initial_vector, VectorType projected_vector)
-        : m_matrix( gen_matrix(initial_vector, projected_vector) )
+    HouseholderGenerator2(const VectorType& initial_vector, const VectorType& projected_vector)
+        : m_gen_v( check_dimensions(initial_vector, projected_vector) )
+        , m_gen_u( gen_u(m_gen_v, projected_vector) )
     {}
 
-    const MatrixType& get_matrix() const
+    ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    //! @brief Matrix times `vec`
+    ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    VectorType apply(const VectorType& vec) const
     {
-        return m_matrix;
+        const unsigned n = m_gen_v.dimension();
+
+        if (vec.dimension() != n)
+        {
+            throw std::logic_error("HouseholderGenerator2 vector dimension mismatch!");
+        }
+
+        VectorType ret = vec;
+        Concat<MapT>::copy_vector_on_vector(ret, m_gen_u.apply(Extract<MapT>::get_vector(vec, 1, n-1)), 1);
+        m_gen_v.apply_in_place(ret);
+
+        return ret;
     }
 
-private:
-    static MatrixType gen_matrix(VectorType v, VectorType u)
+    ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    //! @brief Vector of the basis of index `idx` (i.e. column of the matrix)
+    ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    VectorType get_column(unsigned idx) const
     {
-        if (v.dimension() < 2)
+        if (idx == 0)
         {
-            throw std::logic_error("Dimension of v must not be less than 2!");
+            return m_gen_v.get_column(0);
         }
 
-        if (v.dimension() != u.dimension())
+        VectorType ret(m_gen_v.dimension());
+        Concat<MapT>::copy_vector_on_vector(ret, m_gen_u.get_column(idx-1), 1);
+        m_gen_v.apply_in_place(ret);
+
+        return ret;
+    }
+
+    MatrixType get_matrix() const
+    {
+        const unsigned n = m_gen_v.dimension();
+
+        MatrixType ret(n, n);
+        for (unsigned j = 0; j < n; ++j)
         {
-            throw std::logic_error("Dimension of v must not be equal dimension of u!");
+            const VectorType column = get_column(j);
+
+            for (unsigned i = 0; i < n; ++i)
+            {
+                ret(i+1, j+1) = column[i];
+            }
         }
 
-        const unsigned n = v.dimension();
+        return ret;
+    }
 
-        HouseholderGenerator<MapT> gen(v);
-        const MatrixType mat_v = gen.get_matrix();
+    ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    //! @brief Generate matrices for all pairs of `initial_vectors` and `projected_vectors` according to PolicyT
+    ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    template<typename PolicyT = SequentialExecution>
+    static std::vector<MatrixType> gen_matrices(const std::vector<VectorType>& initial_vectors,
+                                                const std::vector<VectorType>& projected_vectors,
+                                                PolicyT policy = PolicyT())
+    {
+        if (initial_vectors.size() != projected_vectors.size())
+        {
+            throw std::logic_error("HouseholderGenerator2: number of initial and projected vectors mismatch!");
+        }
 
-        MapT proj
+        std::vector<MatrixType> ret(initial_vectors.size());
+
+        policy.run(initial_vectors.size(), [&](size_t i)
         {
-            ProjectionMap<MapT>::create(v.dimension(), IdxList<size_t>::create(1, n-1))
-        };
+            ret[i] = HouseholderGenerator2(initial_vectors[i], projected_vectors[i]).get_matrix();
+        });
 
-        MatrixType P(n - 1, n);
-        const VectorType u_proj = proj(mat_v * u, P);
+        return ret;
+    }
+
+private:
+    static const VectorType& check_dimensions(const VectorType& v, const VectorType& u)
+    {
+        if (v.dimension() < 2)
+        {
+            throw std::logic_error("Dimension of v must not be less than 2!");
+        }
 
-        HouseholderGenerator<MapT> gen_u(u_proj);
-        const MatrixType mat_u = gen_u.get_matrix();
+        if (v.dimension() != u.dimension())
+        {
+            throw std::logic_error("Dimension of v must not be equal dimension of u!");
+        }
 
-        MatrixType mat_u_e = MatrixType::Identity(n);
-        Concat<MapT>::copy_matrix_on_matrix(mat_u_e, mat_u, 1, 1);
+        return v;
+    }
 
-        return mat_v * mat_u_e;
+    static VectorType gen_u(const HouseholderGenerator<MapT>& gen_v, const VectorType& u)
+    {
+        return Extract<MapT>::get_vector(gen_v.apply(u), 1, u.dimension() - 1);
     }
 
-    const MatrixType m_matrix;
+    HouseholderGenerator<MapT> m_gen_v;
+    HouseholderGenerator<MapT> m_gen_u;
 };
 
 }
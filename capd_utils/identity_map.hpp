@@ -36,7 +36,7 @@ public:
     {
         this->assert_vector_size(vec, m_dimension, "IdentityMap vec vector size mismatch (2)!");
 
-        mat = MatrixType::Identity(m_dimension);
+        assign_identity(mat, m_dimension);
 
         return vec;
     }
@@ -51,6 +51,11 @@ public:
         return m_dimension;
     }
 
+    JacobianStructure jacobian_structure() const noexcept override
+    {
+        return JacobianStructure::Identity;
+    }
+
 private:
     size_t m_dimension;
 };
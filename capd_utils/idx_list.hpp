@@ -4,19 +4,111 @@
 
 #pragma once
 
-#include <list>
+#include <algorithm>
+#include <cstddef>
+#include <initializer_list>
+#include <iterator>
+#include <stdexcept>
+#include <vector>
 
 namespace CapdUtils
 {
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 //! @brief Utility to represent list of indices
+//!
+//! @details Indices are stored in contiguous storage as runs of form (first, first+step, ..., first+(length-1)*step)
+//!          with step 0 (fill) or 1 (range), so lists generated by `create` take constant memory regardless of their
+//!          size. Random access costs binary search over runs (constant for lists made by `create`).
 ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 template<typename IdxT>
-class IdxList : public std::list<IdxT>
+class IdxList
 {
 public:
-    using std::list<IdxT>::list;
+    //! Run of indices (first, first+step, ..., first+(length-1)*step)
+    struct Run
+    {
+        IdxT first;
+        IdxT step;
+        size_t length;
+    };
+
+    ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    //! @brief Forward iterator over indices (dereference yields index by value)
+    ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    class const_iterator
+    {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = IdxT;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const IdxT*;
+        using reference = IdxT;
+
+        const_iterator() = default;
+
+        const_iterator(const Run* run, size_t offset) : m_run(run), m_offset(offset)
+        {}
+
+        IdxT operator* () const
+        {
+            return m_run->first + static_cast<IdxT>(m_offset) * m_run->step;
+        }
+
+        const_iterator& operator++ ()
+        {
+            if (++m_offset == m_run->length)
+            {
+                ++m_run;
+                m_offset = 0;
+            }
+
+            return *this;
+        }
+
+        const_iterator operator++ (int)
+        {
+            const_iterator ret = *this;
+            ++(*this);
+            return ret;
+        }
+
+        bool operator== (const const_iterator& other) const
+        {
+            return m_run == other.m_run && m_offset == other.m_offset;
+        }
+
+        bool operator!= (const const_iterator& other) const
+        {
+            return !(*this == other);
+        }
+
+    private:
+        const Run* m_run = nullptr;
+        size_t m_offset = 0;
+    };
+
+    using value_type = IdxT;
+    using iterator = const_iterator;
+
+    IdxList() = default;
+
+    IdxList(std::initializer_list<IdxT> list)
+    {
+        for (const IdxT& idx : list)
+        {
+            push_back(idx);
+        }
+    }
+
+    template<typename IteratorT>
+    IdxList(IteratorT first, IteratorT last)
+    {
+        for (; first != last; ++first)
+        {
+            push_back(*first);
+        }
+    }
 
     ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
     //! Create list of indices of form (offset, offset+1, ..., offset+size-1)
@@ -24,10 +116,7 @@ public:
     static IdxList<IdxT> create(IdxT offset, size_t size)
     {
         IdxList<IdxT> ret;
-        while( ret.size() < size )
-        {
-            ret.push_back( offset++ );
-        }
+        ret.append_run(offset, 1, size);
         return ret;
     }
 
@@ -40,24 +129,111 @@ public:
     static IdxList<IdxT> create(size_t total_size, size_t pos, size_t size, IdxT offset = 0, IdxT fill = -1)
     {
         IdxList<IdxT> ret;
+        ret.append_run(fill, 0, pos);
+        ret.append_run(offset, 1, size);
+        ret.append_run(fill, 0, total_size - std::min(total_size, pos + size));
+        return ret;
+    }
 
-        while (ret.size() < pos)
+    ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    //! Append index (extends the last run if possible)
+    ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    void push_back(IdxT idx)
+    {
+        if (!m_runs.empty())
         {
-            ret.push_back(fill);
+            Run& last = m_runs.back();
+
+            if (last.length == 1 && (idx == last.first || idx == last.first + 1))
+            {
+                last.step = idx - last.first;
+                ++last.length;
+                ++m_size;
+                return;
+            }
+
+            if (last.length > 1 && idx == last.first + static_cast<IdxT>(last.length) * last.step)
+            {
+                ++last.length;
+                ++m_size;
+                return;
+            }
         }
 
-        while( ret.size() < pos + size )
+        append_run(idx, 0, 1);
+    }
+
+    IdxT operator[] (size_t i) const
+    {
+        const auto it = std::upper_bound(m_starts.begin(), m_starts.end(), i) - 1;
+        const Run& run = m_runs[it - m_starts.begin()];
+
+        return run.first + static_cast<IdxT>(i - *it) * run.step;
+    }
+
+    IdxT at(size_t i) const
+    {
+        if (i >= m_size)
         {
-            ret.push_back( offset++ );
+            throw std::out_of_range("IdxList: index is out of range!");
         }
 
-        while (ret.size() < total_size)
+        return (*this)[i];
+    }
+
+    const_iterator begin() const noexcept
+    {
+        return m_runs.empty() ? end() : const_iterator(m_runs.data(), 0);
+    }
+
+    const_iterator end() const noexcept
+    {
+        return const_iterator(m_runs.data() + m_runs.size(), 0);
+    }
+
+    size_t size() const noexcept
+    {
+        return m_size;
+    }
+
+    bool empty() const noexcept
+    {
+        return m_size == 0;
+    }
+
+    //! Compressed representation of the list
+    const std::vector<Run>& runs() const noexcept
+    {
+        return m_runs;
+    }
+
+    bool operator== (const IdxList<IdxT>& other) const
+    {
+        return m_size == other.m_size && std::equal(begin(), end(), other.begin());
+    }
+
+    bool operator!= (const IdxList<IdxT>& other) const
+    {
+        return !(*this == other);
+    }
+
+private:
+    void append_run(IdxT first, IdxT step, size_t length)
+    {
+        if (length > 0)
         {
-            ret.push_back(fill);
+            m_starts.push_back(m_size);
+            m_runs.push_back(Run{ first, step, length });
+            m_size += length;
         }
-
-        return ret;
     }
+
+    std::vector<Run> m_runs {};
+
+    //! Position of the first index of each run
+    std::vector<size_t> m_starts {};
+
+    size_t m_size = 0;
 };
 
 }
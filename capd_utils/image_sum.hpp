@@ -4,8 +4,15 @@
 
 #pragma once
 
+#include <array>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+
 #include "map_base.hpp"
 #include "map_compatibility.hpp"
+#include "map_tuple.hpp"
+#include "execution_policy.hpp"
 
 #include "concat.hpp"
 
@@ -16,33 +23,53 @@ namespace CapdUtils
 //! @brief Image sum implementation
 //!
 //! @details F(x) = [ f_1(x), ..., f_n(x) ]
+//!
+//!  Maps are stored in a flat tuple and offsets of images are computed at construction, so each map writes its value and
+//!  derivative directly into the preallocated output.
+//!
+//!  Maps are evaluated according to PolicyT (SequentialExecution or ParallelExecution). Each map writes to its own block of
+//!  the output, so no synchronization is needed; with ParallelExecution the maps must not share state (e.g. the same
+//!  solver object referenced twice).
 ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
-template<typename MapT, typename MapU, typename... MapV>
-class ImageSum : public MapBase<MapT>
+template<typename PolicyT, typename MapT, typename MapU, typename... MapV>
+class BasicImageSum : public MapBase<MapT>
 {
 public:
-    static_assert(MapCompatibility<MapT, MapU>::value);
+    static_assert(MapCompatibility<MapT, MapU>::value && (MapCompatibility<MapT, MapV>::value && ...));
 
     using ScalarType = typename MapT::ScalarType;
     using VectorType = typename MapT::VectorType;
     using MatrixType = typename MapT::MatrixType;
 
-    ImageSum(MapU map_1, MapV... map_2_args) : m_map_1(map_1), m_map_2(map_2_args...)
+    BasicImageSum(MapU map_1, MapV... map_2_args) : BasicImageSum(PolicyT(), map_1, map_2_args...)
+    {}
+
+    BasicImageSum(PolicyT policy, MapU map_1, MapV... map_2_args)
+        : m_policy(policy)
+        , m_maps(map_1, map_2_args...)
+        , m_dimension( map_1.dimension() )
+        , m_out_offsets( get_map_offsets(m_maps, [](const auto& map) { return map.imageDimension(); }) )
     {
-        if (m_map_1.dimension() != m_map_2.dimension())
+        for_each_map(m_maps, [this](const auto& map, size_t)
         {
-            throw std::logic_error("ImageSum dimension mismatch!");
-        }
+            if (map.dimension() != m_dimension)
+            {
+                throw std::logic_error("ImageSum dimension mismatch!");
+            }
+        });
     }
 
     VectorType operator() (const VectorType& vec) override
     {
         this->assert_vector_size(vec, this->dimension(), "ImageSum vec vector size mismatch (1)!");
 
-        const VectorType v1 = m_map_1(vec);
-        const VectorType v2 = m_map_2(vec);
+        VectorType ret( this->imageDimension() );
+
+        evaluate([&](auto& map, size_t i)
+        {
+            Concat<MapT>::copy_vector_on_vector(ret, map(vec), m_out_offsets[i]);
+        });
 
-        const VectorType ret = Concat<MapT>::concat_vectors({ v1, v2 });
         return ret;
     }
 
@@ -50,79 +77,69 @@ public:
     {
         this->assert_vector_size(vec, this->dimension(), "ImageSum vec vector size mismatch (2)!");
 
-        MatrixType m1(m_map_1.imageDimension(), m_map_1.dimension());
-        const VectorType v1 = m_map_1(vec, m1);
-        this->assert_matrix_size(m1, m_map_1.imageDimension(), m_map_1.dimension(), "ImageSum m1 matrix size mismatch!");
+        VectorType ret( this->imageDimension() );
+
+        if (mat.dimension() != std::make_pair(this->imageDimension(), this->dimension()))
+        {
+            mat = MatrixType(this->imageDimension(), this->dimension());
+        }
+
+        evaluate([&](auto& map, size_t i)
+        {
+            const unsigned rows = m_out_offsets[i+1] - m_out_offsets[i];
+
+            MatrixType& der = m_ders[i];
+            if (der.dimension() != std::make_pair(rows, m_dimension))
+            {
+                der = MatrixType(rows, m_dimension);
+            }
 
-        MatrixType m2(m_map_2.imageDimension(), m_map_2.dimension());
-        const VectorType v2 = m_map_2(vec, m2);
-        this->assert_matrix_size(m2, m_map_2.imageDimension(), m_map_2.dimension(), "ImageSum m2 matrix size mismatch!");
+            Concat<MapT>::copy_vector_on_vector(ret, map(vec, der), m_out_offsets[i]);
+            this->assert_matrix_size(der, rows, m_dimension, "ImageSum m" + std::to_string(i+1) + " matrix size mismatch!");
 
-        const VectorType ret = Concat<MapT>::concat_vectors({ v1, v2 });
+            Concat<MapT>::copy_matrix_on_matrix(mat, der, m_out_offsets[i], 0);
+        });
 
-        mat = MatrixType(this->imageDimension(), this->dimension());
-        Concat<MapT>::copy_matrix_on_matrix(mat, m1, 0, 0);
-        Concat<MapT>::copy_matrix_on_matrix(mat, m2, m_map_1.imageDimension(), 0);
         return ret;
     }
 
     unsigned dimension() const noexcept override
     {
-        return m_map_1.dimension();
+        return m_dimension;
     }
 
     unsigned imageDimension() const noexcept override
     {
-        return m_map_1.imageDimension() + m_map_2.imageDimension();
+        return m_out_offsets.back();
     }
 
 private:
-    MapU m_map_1;
-    ImageSum<MapT, MapV...> m_map_2;
-};
-
-
-template<typename MapT, typename MapU>
-class ImageSum<MapT, MapU> : public MapBase<MapT>
-{
-public:
-    static_assert(MapCompatibility<MapT, MapU>::value);
-
-    using ScalarType = typename MapT::ScalarType;
-    using VectorType = typename MapT::VectorType;
-    using MatrixType = typename MapT::MatrixType;
-
-    ImageSum(MapU map) : m_map(map)
-    {}
+    static constexpr size_t m_size = 1 + sizeof...(MapV);
 
-    VectorType operator() (const VectorType& vec) override
+    //! Evaluate func(map, index) for all maps according to the execution policy
+    template<typename FuncT>
+    void evaluate(FuncT&& func)
     {
-        this->assert_vector_size(vec, m_map.dimension(), "ImageSum vec vector size mismatch (1)!");
-        return m_map(vec);
+        m_policy.run(m_size, [&](size_t index)
+        {
+            visit_map(m_maps, index, func);
+        });
     }
 
-    VectorType operator() (const VectorType& vec, MatrixType& mat) override
-    {
-        this->assert_vector_size(vec, m_map.dimension(), "ImageSum vec vector size mismatch (2)!");
-
-        const VectorType ret = m_map(vec, mat);
-        this->assert_matrix_size(mat, m_map.imageDimension(), m_map.dimension(), "ImageSum mat matrix size mismatch!");
+    PolicyT m_policy;
+    std::tuple<MapU, MapV...> m_maps;
 
-        return ret;
-    }
+    const unsigned m_dimension;
+    const std::array<unsigned, m_size + 1> m_out_offsets;
 
-    unsigned dimension() const noexcept override
-    {
-        return m_map.dimension();
-    }
+    //! Derivatives of maps (reused between evaluations)
+    std::array<MatrixType, m_size> m_ders {};
+};
 
-    unsigned imageDimension() const noexcept override
-    {
-        return m_map.imageDimension();
-    }
+template<typename MapT, typename MapU, typename... MapV>
+using ImageSum = BasicImageSum<SequentialExecution, MapT, MapU, MapV...>;
 
-private:
-    MapU m_map;
-};
+template<typename MapT, typename MapU, typename... MapV>
+using ParallelImageSum = BasicImageSum<ParallelExecution, MapT, MapU, MapV...>;
 
 }
@@ -0,0 +1,155 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Author: Aleksander M. Pasiut
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <utility>
+
+namespace CapdUtils
+{
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//! @brief Structure of the Jacobian reported by maps
+//!
+//! @details The derivative is always returned as a dense matrix, the tag only allows composing maps to skip work:
+//!          - Dense:    no structure is known,
+//!          - Sparse:   each row has at most one block of nonzero entries scattered from a smaller map (e.g. PNE),
+//!          - Diagonal: square matrix with nonzero entries on the diagonal only,
+//!          - Identity: identity matrix.
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+enum class JacobianStructure
+{
+    Dense,
+    Sparse,
+    Diagonal,
+    Identity
+};
+
+namespace JacobianStructureInternal
+{
+    template<typename MapU>
+    auto get(const MapU& map, int) -> decltype(map.jacobian_structure())
+    {
+        return map.jacobian_structure();
+    }
+
+    template<typename MapU>
+    JacobianStructure get(const MapU&, long)
+    {
+        return JacobianStructure::Dense;
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//! @brief Jacobian structure of any map (Dense for maps without the tag, e.g. CAPD maps)
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+template<typename MapU>
+JacobianStructure get_jacobian_structure(const MapU& map)
+{
+    return JacobianStructureInternal::get(map, 0);
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//! @brief Resize `mat` to (rows, cols) and fill it with zeros (storage is reused if size matches)
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+template<typename MatrixType>
+void assign_zero(MatrixType& mat, unsigned rows, unsigned cols)
+{
+    if (mat.dimension() == std::make_pair(rows, cols))
+    {
+        mat.clear();
+    }
+    else
+    {
+        mat = MatrixType(rows, cols);
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//! @brief Assign identity matrix of size n to `mat` (storage is reused if size matches)
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+template<typename MatrixType>
+void assign_identity(MatrixType& mat, unsigned n)
+{
+    assign_zero(mat, n, n);
+
+    for (unsigned i = 1; i <= n; ++i)
+    {
+        mat(i, i) = 1.0;
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//! @brief Jacobian of composition outer(inner(x)), where multiplications by identity and diagonal factors are skipped
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+template<typename MatrixType>
+MatrixType compose_jacobians(
+    const MatrixType& outer,
+    JacobianStructure outer_structure,
+    const MatrixType& inner,
+    JacobianStructure inner_structure)
+{
+    if (outer_structure == JacobianStructure::Identity)
+    {
+        return inner;
+    }
+
+    if (inner_structure == JacobianStructure::Identity)
+    {
+        return outer;
+    }
+
+    if (outer_structure == JacobianStructure::Diagonal)
+    {
+        MatrixType ret = inner;
+        for (unsigned i = 1; i <= ret.numberOfRows(); ++i)
+        {
+            for (unsigned j = 1; j <= ret.numberOfColumns(); ++j)
+            {
+                ret(i, j) *= outer(i, i);
+            }
+        }
+        return ret;
+    }
+
+    if (inner_structure == JacobianStructure::Diagonal)
+    {
+        MatrixType ret = outer;
+        for (unsigned i = 1; i <= ret.numberOfRows(); ++i)
+        {
+            for (unsigned j = 1; j <= ret.numberOfColumns(); ++j)
+            {
+                ret(i, j) *= inner(j, j);
+            }
+        }
+        return ret;
+    }
+
+    return outer * inner;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//! @brief Structure of composition of maps with given structures
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+inline JacobianStructure compose_structures(JacobianStructure outer, JacobianStructure inner)
+{
+    if (outer == JacobianStructure::Identity)
+    {
+        return inner;
+    }
+
+    if (inner == JacobianStructure::Identity)
+    {
+        return outer;
+    }
+
+    if (outer == JacobianStructure::Diagonal && inner == JacobianStructure::Diagonal)
+    {
+        return JacobianStructure::Diagonal;
+    }
+
+    return JacobianStructure::Dense;
+}
+
+}
@@ -4,7 +4,12 @@
 
 #pragma once
 
-#include "newton_method.expander.hpp"
+#include <string>
+
+#include "capd/basic_tools.hpp"
+#include "capd/gauss_solver.hpp"
+#include "block_sparse_matrix.hpp"
+#include "checkpoint.hpp"
 #include "type_cast.hpp"
 
 namespace CapdUtils
@@ -22,18 +27,69 @@ public:
     {}
 
     bool bound_solution(VectorType& root_with_epsilon, VectorType root, size_t max_steps)
+    {
+        return bound_solution_internal(root_with_epsilon, root, max_steps, nullptr);
+    }
+
+    ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    //! @brief Bound solution with checkpointing
+    //!
+    //! The current step, root with epsilon and the preconditioning data are saved into `checkpoint` after each step.
+    //! If `checkpoint` contains state of the computation started for the same `root` and the same map (identified by
+    //! its value at `root`), the computation is resumed. The checkpoint is removed when the computation completes.
+    ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    bool bound_solution(VectorType& root_with_epsilon, VectorType root, size_t max_steps, Checkpoint& checkpoint)
+    {
+        return bound_solution_internal(root_with_epsilon, root, max_steps, &checkpoint);
+    }
+
+private:
+    static std::string checkpoint_tag()
+    {
+        return "KrawczykMethodExpander/" + std::to_string(BinaryScalarCodec<ScalarType>::kind);
+    }
+
+    bool bound_solution_internal(VectorType& root_with_epsilon, VectorType root, size_t max_steps, Checkpoint* checkpoint)
     {
         if (subset(root, root_with_epsilon))
         {
-            MatrixType invC(root.dimension(), root.dimension());
-            const VectorType val = m_map(root, invC);
+            size_t first_step = 0;
+            VectorType val {};
+            MatrixType C {};
+
+            const VectorType map_value = checkpoint ? m_map(root) : VectorType();
 
-            invC = matrix_cast<MatrixType>( matrix_cast<RMatrix>(invC) );
+            const bool resumed = checkpoint && checkpoint->load(checkpoint_tag(), [&](CheckpointReader& reader) -> bool
+            {
+                const VectorType file_root = reader.read_vector<MapT>();
+                const VectorType file_map_value = reader.read_vector<MapT>();
+
+                if (file_root == root && file_map_value == map_value)
+                {
+                    first_step = reader.read_index();
+                    root_with_epsilon = reader.read_vector<MapT>();
+                    val = reader.read_vector<MapT>();
+                    C = reader.read_matrix<MapT>();
+                    return true;
+                }
+                else
+                {
+                    return false;
+                }
+            });
+
+            if (resumed == false)
+            {
+                MatrixType invC {};
+                val = evaluate_dense(root, invC);
 
-            MatrixType C = gaussInverseMatrix<MapT>(invC);
-            C = matrix_cast<MatrixType>( matrix_cast<RMatrix>(C) );
+                invC = matrix_cast<MatrixType>( matrix_cast<RMatrix>(invC) );
 
-            for (size_t step = 0; step < max_steps; ++step)
+                C = gaussInverseMatrix<MapT>(invC);
+                C = matrix_cast<MatrixType>( matrix_cast<RMatrix>(C) );
+            }
+
+            for (size_t step = first_step; step < max_steps; ++step)
             {
                 const VectorType interior = get_interior(root_with_epsilon, root, val, C);
 
@@ -46,10 +102,34 @@ public:
                 if ( subset(interior, root_with_epsilon) )
                 {
                     combine_root(root_with_epsilon, interior, root);
+
+                    if (checkpoint)
+                    {
+                        checkpoint->remove();
+                    }
+
                     return true;
                 }
 
                 combine_root(root_with_epsilon, interior, root);
+
+                if (checkpoint)
+                {
+                    checkpoint->update(checkpoint_tag(), [&](CheckpointWriter& writer)
+                    {
+                        writer.write_vector<MapT>(root);
+                        writer.write_vector<MapT>(map_value);
+                        writer.write_index(step + 1);
+                        writer.write_vector<MapT>(root_with_epsilon);
+                        writer.write_vector<MapT>(val);
+                        writer.write_matrix<MapT>(C);
+                    });
+                }
+            }
+
+            if (checkpoint)
+            {
+                checkpoint->remove();
             }
 
             return false;
@@ -60,7 +140,6 @@ public:
         }
     }
 
-private:
     static void combine_root(VectorType& root_with_epsilon, const VectorType& interior, const VectorType& root)
     {
         for (unsigned i = 0; i < root_with_epsilon.dimension(); ++i)
@@ -71,11 +150,45 @@ private:
 
     VectorType get_interior(VectorType& root_with_epsilon, VectorType root, VectorType val, const MatrixType& C)
     {
-        MatrixType der( root.dimension(), root.dimension() );
-        m_map(root_with_epsilon, der);
+        MatrixType id_minus_c_der = MatrixType::Identity( root.dimension() );
+        id_minus_c_der -= get_c_der(root_with_epsilon, C);
+
+        return root - C * val + id_minus_c_der * (root_with_epsilon - root);
+    }
+
+    ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    //! @brief C * DF(vec); the derivative is kept sparse if the map provides it (see HasSparseJacobian)
+    ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    MatrixType get_c_der(const VectorType& vec, const MatrixType& C)
+    {
+        if constexpr (HasSparseJacobian<MapT>::value)
+        {
+            typename MapT::SparseMatrixType der {};
+            m_map(vec, der);
+            return der.left_multiply(C);
+        }
+        else
+        {
+            MatrixType der( vec.dimension(), vec.dimension() );
+            m_map(vec, der);
+            return C * der;
+        }
+    }
 
-        const MatrixType id = MatrixType::Identity( root.dimension() );
-        return root - C * val + (id - C * der)*(root_with_epsilon - root);
+    VectorType evaluate_dense(const VectorType& vec, MatrixType& der)
+    {
+        if constexpr (HasSparseJacobian<MapT>::value)
+        {
+            typename MapT::SparseMatrixType sparse_der {};
+            const VectorType ret = m_map(vec, sparse_der);
+            der = sparse_der.to_dense();
+            return ret;
+        }
+        else
+        {
+            der = MatrixType(vec.dimension(), vec.dimension());
+            return m_map(vec, der);
+        }
     }
 
     MapT& m_map;
@@ -12,6 +12,18 @@
 namespace CapdUtils
 {
 
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//! @brief Evaluation mode of local map derivative
+//!
+//! Separate - derivative is evaluated at the point, value multiplier over the hull with the source origin
+//! Fused    - both are taken from the single hull evaluation (derivative is wider, but the underlying map is evaluated once)
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+enum class LocalMapEvaluation
+{
+    Separate,
+    Fused
+};
+
 ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 //! @brief Local map implementation (base)
 ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -27,9 +39,9 @@ public:
 
     VectorType operator() (const VectorType& vec, MatrixType& mat) override
     {
-        mat = get_derivative(vec);
-
         const MatrixType multiplier = get_multiplier(vec);
+        mat = is_fused() ? multiplier : get_derivative(vec);
+
         return multiplier * vec + m_shift;
     }
 
@@ -56,15 +68,18 @@ protected:
     //! @param map         underlying global map
     //! @param source      local coordinate system around source point
     //! @param destination local coordinate system around destination point
+    //! @param evaluation  evaluation mode of derivative
     ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
     LocalMapBase(
         MapU& map,
         const LocalCoordinateSystem<MapT>& source,
-        const LocalCoordinateSystem<MapT>& destination)
+        const LocalCoordinateSystem<MapT>& destination,
+        LocalMapEvaluation evaluation)
             : m_map(map)
             , m_source(source)
             , m_destination(destination)
             , m_shift( this->compute_shift() )
+            , m_evaluation(evaluation)
     {
         if (map.dimension() != source.get_origin().dimension())
         {
@@ -78,9 +93,11 @@ protected:
     }
 
     ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
-    //! @brief Return solution of A*X = B with respect to X
+    //! @brief Return solution of A*X = B with respect to X, where A is directions matrix of destination
+    //!
+    //! A never changes after construction, so implementations are expected to precompute its inverse.
     ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
-    virtual MatrixType solveMatrix(const MatrixType& A, const MatrixType& B) = 0;
+    virtual MatrixType solveMatrix(const MatrixType& B) = 0;
 
     ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
     //! @brief Return interval hull of A and B
@@ -88,6 +105,11 @@ protected:
     virtual VectorType intervalHull(const VectorType& A, const VectorType& B) = 0;
 
 private:
+    bool is_fused() const noexcept
+    {
+        return m_evaluation == LocalMapEvaluation::Fused || capd::TypeTraits<ScalarType>::isInterval == false;
+    }
+
     MatrixType get_multiplier(const VectorType& vec)
     {
         const MatrixType& a1 = m_source.get_directions_matrix();
@@ -97,8 +119,7 @@ private:
         MatrixType der(this->m_map.imageDimension(), this->m_map.dimension());
         m_map(vec_extended, der);
 
-        const MatrixType a2 = m_destination.get_directions_matrix();
-        const MatrixType ret = solveMatrix(a2, der * a1);
+        const MatrixType ret = solveMatrix(der * a1);
         return ret;
     }
 
@@ -110,8 +131,7 @@ private:
         MatrixType der(this->m_map.imageDimension(), this->m_map.dimension());
         m_map(vec_in_origin, der);
 
-        const MatrixType a2 = m_destination.get_directions_matrix();
-        const MatrixType ret = solveMatrix(a2, der * a1);
+        const MatrixType ret = solveMatrix(der * a1);
         return ret;
     }
 
@@ -128,6 +148,8 @@ private:
     const LocalCoordinateSystem<MapT> m_destination;
 
     const VectorType m_shift;
+
+    const LocalMapEvaluation m_evaluation;
 };
 
 }
@@ -58,16 +58,19 @@ public:
     //! @param map         underlying global map
     //! @param source      local coordinate system around source point
     //! @param destination local coordinate system around destination point
+    //! @param evaluation  evaluation mode of derivative
     ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
     LocalMap(
         MapU& map,
         const LocalCoordinateSystem<MapT>& source,
-        const LocalCoordinateSystem<MapT>& destination)
+        const LocalCoordinateSystem<MapT>& destination,
+        LocalMapEvaluation evaluation = LocalMapEvaluation::Separate)
             : m_map(map)
             , m_source(source)
             , m_destination(destination)
             , m_dest_directions_inverse( gaussInverseMatrix<MapT>(m_destination.get_directions_matrix()) )
             , m_shift( this->compute_shift() )
+            , m_evaluation(evaluation)
     {
         if (map.dimension() != source.get_origin().dimension())
         {
@@ -82,9 +85,9 @@ public:
 
     VectorType operator() (const VectorType& vec, MatrixType& mat) override
     {
-        mat = get_derivative(vec);
-
         const MatrixType multiplier = get_multiplier(vec);
+        mat = is_fused() ? multiplier : get_derivative(vec);
+
         return multiplier * vec + m_shift;
     }
 
@@ -105,6 +108,11 @@ public:
     }
 
 private:
+    bool is_fused() const noexcept
+    {
+        return m_evaluation == LocalMapEvaluation::Fused || is_interval == false;
+    }
+
     MatrixType get_multiplier(const VectorType& vec)
     {
         const MatrixType& a1 = m_source.get_directions_matrix();
@@ -144,6 +152,8 @@ private:
     const MatrixType m_dest_directions_inverse;
     const VectorType m_shift;
 
+    const LocalMapEvaluation m_evaluation;
+
 	static constexpr bool is_interval = capd::TypeTraits<ScalarType>::isInterval;
     using IntervalHull = IntervalHull_LocalMapInternal<MapT, is_interval>;
 };
@@ -172,11 +182,15 @@ public:
     //! @param map         underlying global map
     //! @param source      local coordinate system around source point
     //! @param destination local coordinate system around destination point
+    //! @param evaluation  evaluation mode of derivative
     ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
     LocalMapRmi(
         MapU& map,
         const LocalCoordinateSystem<MapT>& source,
-        const LocalCoordinateSystem<MapT>& destination) : LocalMapBase<MapT, MapU>(map, source, destination)
+        const LocalCoordinateSystem<MapT>& destination,
+        LocalMapEvaluation evaluation = LocalMapEvaluation::Separate)
+            : LocalMapBase<MapT, MapU>(map, source, destination, evaluation)
+            , m_dest_directions_inverse( gaussInverseMatrix<MapT>(destination.get_directions_matrix()) )
     {}
 
 private:
@@ -185,10 +199,12 @@ private:
         return capd::vectalg::intervalHull(A, B);
     }
 
-    virtual MatrixType solveMatrix(const MatrixType& A, const MatrixType& B) override final
+    virtual MatrixType solveMatrix(const MatrixType& B) override final
     {
-        return gaussInverseMatrix<MapT>(A) * B;
+        return m_dest_directions_inverse * B;
     }
+
+    const MatrixType m_dest_directions_inverse;
 };
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -212,11 +228,16 @@ public:
     //! @param map         underlying global map
     //! @param source      local coordinate system around source point
     //! @param destination local coordinate system around destination point
+    //! @param evaluation  evaluation mode of derivative
     ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
     LocalMapMii(
         MapU& map,
         const LocalCoordinateSystem<MapT>& source,
-        const LocalCoordinateSystem<MapT>& destination) : LocalMapBase<MapT, MapU>(map, source, destination)
+        const LocalCoordinateSystem<MapT>& destination,
+        LocalMapEvaluation evaluation = LocalMapEvaluation::Separate)
+            : LocalMapBase<MapT, MapU>(map, source, destination, evaluation)
+            , m_dest_directions_solver( destination.get_directions_matrix() )
+            , m_dest_directions_inverse( gaussInverseMatrix<MapT>(destination.get_directions_matrix()) )
     {}
 
 private:
@@ -225,10 +246,13 @@ private:
         return capd::vectalg::intervalHull(A, B);
     }
 
-    virtual MatrixType solveMatrix(const MatrixType& A, const MatrixType& B) override final
+    virtual MatrixType solveMatrix(const MatrixType& B) override final
     {
-        return gaussMatrixSolverWithIntersect<MapT>(A, B);
+        return gaussMatrixSolverWithIntersect<MapT>(m_dest_directions_solver, m_dest_directions_inverse, B);
     }
+
+    const GaussMatrixSolver<MapT> m_dest_directions_solver;
+    const MatrixType m_dest_directions_inverse;
 };
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -256,7 +280,9 @@ public:
     LocalMapReal(
         MapU& map,
         const LocalCoordinateSystem<MapT>& source,
-        const LocalCoordinateSystem<MapT>& destination) : LocalMapBase<MapT, MapU>(map, source, destination)
+        const LocalCoordinateSystem<MapT>& destination)
+            : LocalMapBase<MapT, MapU>(map, source, destination, LocalMapEvaluation::Fused)
+            , m_dest_directions_inverse( gaussInverseMatrix<MapT>(destination.get_directions_matrix()) )
     {}
 
 private:
@@ -265,10 +291,12 @@ private:
         return B;
     }
 
-    virtual MatrixType solveMatrix(const MatrixType& A, const MatrixType& B) override final
+    virtual MatrixType solveMatrix(const MatrixType& B) override final
     {
-        return gaussInverseMatrix<MapT>(A) * B;
+        return m_dest_directions_inverse * B;
     }
+
+    const MatrixType m_dest_directions_inverse;
 };
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
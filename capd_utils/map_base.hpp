@@ -9,6 +9,8 @@
 #include <string>
 #include <sstream>
 
+#include "jacobian_structure.hpp"
+
 namespace CapdUtils
 {
 
@@ -31,6 +33,14 @@ public:
 
     virtual unsigned imageDimension() const = 0;
 
+    ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    //! @brief Structure of the Jacobian returned by operator()(vec, mat)
+    ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    virtual JacobianStructure jacobian_structure() const
+    {
+        return JacobianStructure::Dense;
+    }
+
     ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
     //! @brief Utility function allowing to assert the size of matrix
     ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,67 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Author: Aleksander M. Pasiut
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <tuple>
+#include <utility>
+
+namespace CapdUtils
+{
+
+namespace MapTupleInternal
+{
+    template<typename TupleT, typename FuncT, size_t... I>
+    void for_each(TupleT& maps, FuncT&& func, std::index_sequence<I...>)
+    {
+        (func(std::get<I>(maps), I), ...);
+    }
+
+    template<typename TupleT, typename FuncT, size_t... I>
+    void visit(TupleT& maps, size_t index, FuncT&& func, std::index_sequence<I...>)
+    {
+        ((index == I ? func(std::get<I>(maps), I) : void()), ...);
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//! @brief Call func(map, index) for each map of the tuple (in order, without virtual dispatch)
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+template<typename TupleT, typename FuncT>
+void for_each_map(TupleT& maps, FuncT&& func)
+{
+    constexpr size_t size = std::tuple_size<std::remove_const_t<TupleT>>::value;
+    MapTupleInternal::for_each(maps, std::forward<FuncT>(func), std::make_index_sequence<size>{});
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//! @brief Call func(map, index) for the map with given (runtime) index
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+template<typename TupleT, typename FuncT>
+void visit_map(TupleT& maps, size_t index, FuncT&& func)
+{
+    constexpr size_t size = std::tuple_size<std::remove_const_t<TupleT>>::value;
+    MapTupleInternal::visit(maps, index, std::forward<FuncT>(func), std::make_index_sequence<size>{});
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//! @brief Offsets of consecutive blocks of sizes get_size(map), i.e. { 0, s_1, s_1 + s_2, ..., s_1 + ... + s_n }
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+template<typename TupleT, typename SizeFuncT>
+auto get_map_offsets(TupleT& maps, SizeFuncT get_size)
+{
+    constexpr size_t size = std::tuple_size<std::remove_const_t<TupleT>>::value;
+
+    std::array<unsigned, size + 1> ret {};
+    for_each_map(maps, [&](const auto& map, size_t i)
+    {
+        ret[i+1] = ret[i] + get_size(map);
+    });
+
+    return ret;
+}
+
+}
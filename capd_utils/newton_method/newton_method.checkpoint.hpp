@@ -0,0 +1,162 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Author: Aleksander M. Pasiut
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <string>
+
+#include <capd_utils/checkpoint.hpp>
+#include <capd_utils/capd/basic_tools.hpp>
+
+#include "newton_method.roots_list.hpp"
+
+namespace CapdUtils
+{
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//! @brief Checkpoint of Newton method state
+//!
+//! @details The tag contains the scalar kind of MapT (see BinaryScalarCodec), so checkpoint saved with other scalar type
+//!          is rejected. The state is keyed with the initial root and the value of the map at its midpoint (identity of
+//!          the map, e.g. its parameters), so checkpoint of other computation is never resumed. Two phases are
+//!          distinguished: root search (current iterate and the best root found so far) and root bounding (root
+//!          midpoint and current root enclosure). The checkpoint is removed by `finish` when the computation completes.
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+template<typename MapT>
+class NewtonMethodCheckpoint
+{
+public:
+    using ScalarType = typename MapT::ScalarType;
+    using VectorType = typename MapT::VectorType;
+    using MatrixType = typename MapT::MatrixType;
+
+    NewtonMethodCheckpoint(Checkpoint* checkpoint, MapT& map, const VectorType& initial_root)
+        : m_checkpoint(checkpoint)
+        , m_tag("NewtonMethod/" + std::to_string(BinaryScalarCodec<ScalarType>::kind))
+        , m_key(initial_root)
+        , m_map_value(checkpoint ? map(mid_vector(initial_root)) : VectorType())
+    {}
+
+    ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    //! @brief Remove checkpoint of completed computation
+    ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    void finish()
+    {
+        if (m_checkpoint)
+        {
+            m_checkpoint->remove();
+        }
+    }
+
+    void save_search(std::size_t step, const Root<MapT>& root, const RootsList<MapT>& roots)
+    {
+        if (m_checkpoint)
+        {
+            const Root<MapT> best_root = roots.best_root();
+
+            m_checkpoint->update(m_tag, [&](CheckpointWriter& writer)
+            {
+                write_key(writer);
+                writer.write_index(phase_search);
+                writer.write_index(step);
+                writer.write_vector<MapT>(root.argument);
+                writer.write_vector<MapT>(best_root.argument);
+                writer.write_scalar<MapT>(best_root.value_norm);
+            });
+        }
+    }
+
+    bool load_search(std::size_t& step, Root<MapT>& root, RootsList<MapT>& roots)
+    {
+        if (m_checkpoint)
+        {
+            return m_checkpoint->load(m_tag, [&](CheckpointReader& reader) -> bool
+            {
+                if (check_key_and_phase(reader, phase_search))
+                {
+                    step = reader.read_index();
+                    root.argument = reader.read_vector<MapT>();
+
+                    Root<MapT> best_root {};
+                    best_root.argument = reader.read_vector<MapT>();
+                    best_root.value_norm = reader.read_scalar<MapT>();
+                    roots.push_back(best_root);
+                    return true;
+                }
+                else
+                {
+                    return false;
+                }
+            });
+        }
+        else
+        {
+            return false;
+        }
+    }
+
+    void save_bound(std::size_t step, const VectorType& root_midpoint, const VectorType& root)
+    {
+        if (m_checkpoint)
+        {
+            m_checkpoint->save(m_tag, [&](CheckpointWriter& writer)
+            {
+                write_key(writer);
+                writer.write_index(phase_bound);
+                writer.write_index(step);
+                writer.write_vector<MapT>(root_midpoint);
+                writer.write_vector<MapT>(root);
+            });
+        }
+    }
+
+    bool load_bound(std::size_t& step, VectorType& root_midpoint, VectorType& root)
+    {
+        if (m_checkpoint)
+        {
+            return m_checkpoint->load(m_tag, [&](CheckpointReader& reader) -> bool
+            {
+                if (check_key_and_phase(reader, phase_bound))
+                {
+                    step = reader.read_index();
+                    root_midpoint = reader.read_vector<MapT>();
+                    root = reader.read_vector<MapT>();
+                    return true;
+                }
+                else
+                {
+                    return false;
+                }
+            });
+        }
+        else
+        {
+            return false;
+        }
+    }
+
+private:
+    void write_key(CheckpointWriter& writer) const
+    {
+        writer.write_vector<MapT>(m_key);
+        writer.write_vector<MapT>(m_map_value);
+    }
+
+    bool check_key_and_phase(CheckpointReader& reader, std::uint64_t phase) const
+    {
+        const VectorType key = reader.read_vector<MapT>();
+        const VectorType map_value = reader.read_vector<MapT>();
+        return key == m_key && map_value == m_map_value && reader.read_index() == phase;
+    }
+
+    static constexpr std::uint64_t phase_search = 0;
+    static constexpr std::uint64_t phase_bound = 1;
+
+    Checkpoint* m_checkpoint;
+    const std::string m_tag;
+    const VectorType m_key;
+    const VectorType m_map_value;
+};
+
+}
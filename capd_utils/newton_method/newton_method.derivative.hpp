@@ -0,0 +1,81 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Author: Aleksander M. Pasiut
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <capd_utils/block_sparse_matrix.hpp>
+#include <capd_utils/capd/basic_tools.hpp>
+#include <capd_utils/capd/gauss_solver.hpp>
+
+namespace CapdUtils
+{
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//! @brief Derivative used by point Newton steps
+//!
+//! @details Maps providing sparse derivative (see HasSparseJacobian, e.g. parallel shooting maps) keep it sparse and the
+//!          step is solved by BlockSparseMatrix::solve, other maps use dense derivative and the Gauss solver.
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+template<typename MapT, bool is_sparse = HasSparseJacobian<MapT>::value>
+class NewtonMethodDerivative
+{
+public:
+    using VectorType = typename MapT::VectorType;
+    using MatrixType = typename MapT::MatrixType;
+
+    NewtonMethodDerivative(unsigned dimension) : m_der(dimension, dimension)
+    {}
+
+    //! Value of `map` at `vec`, the derivative is stored
+    VectorType evaluate(MapT& map, const VectorType& vec)
+    {
+        return map(vec, m_der);
+    }
+
+    //! Replace the derivative by its midpoint
+    void to_midpoint()
+    {
+        m_der = mid_matrix(m_der);
+    }
+
+    //! Solution of DF * dx = value
+    VectorType solve(const VectorType& value) const
+    {
+        return gauss<MapT>(m_der, value);
+    }
+
+private:
+    MatrixType m_der;
+};
+
+template<typename MapT>
+class NewtonMethodDerivative<MapT, true>
+{
+public:
+    using VectorType = typename MapT::VectorType;
+    using MatrixType = typename MapT::MatrixType;
+
+    NewtonMethodDerivative(unsigned)
+    {}
+
+    VectorType evaluate(MapT& map, const VectorType& vec)
+    {
+        return map(vec, m_der);
+    }
+
+    void to_midpoint()
+    {
+        m_der.transform([](const MatrixType& block) { return mid_matrix(block); });
+    }
+
+    VectorType solve(const VectorType& value) const
+    {
+        return m_der.solve(value);
+    }
+
+private:
+    typename MapT::SparseMatrixType m_der;
+};
+
+}
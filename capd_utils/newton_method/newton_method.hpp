@@ -12,6 +12,8 @@
 #include <capd_utils/capd/norm.hpp>
 
 #include "newton_method.roots_list.hpp"
+#include "newton_method.checkpoint.hpp"
+#include "newton_method.derivative.hpp"
 
 namespace CapdUtils
 {
@@ -28,24 +30,29 @@ public:
     using VectorType = typename MapT::VectorType;
     using MatrixType = typename MapT::MatrixType;
 
-    NewtonMethodInternal(MapT& map, const VectorType& initial_root, size_t max_steps)
+    NewtonMethodInternal(MapT& map, const VectorType& initial_root, size_t max_steps, Checkpoint* checkpoint)
     {
-        MatrixType der( initial_root.dimension(), initial_root.dimension() );
+        NewtonMethodDerivative<MapT> der( initial_root.dimension() );
 
         MaxNorm<MapT> norm {};
         RootsList<MapT> roots {};
         Root<MapT> root {};
         root.argument = initial_root;
 
-        for (size_t i = 0;; ++i)
+        NewtonMethodCheckpoint<MapT> state(checkpoint, map, initial_root);
+
+        size_t first_step = 0;
+        state.load_search(first_step, root, roots);
+
+        for (size_t i = first_step;; ++i)
         {
-            const VectorType value = map(root.argument, der);
+            const VectorType value = der.evaluate(map, root.argument);
             root.value_norm = norm(value);
             roots.push_back(root);
 
             if (i < max_steps)
             {
-                const VectorType dx = gauss<MapT>(der, value);
+                const VectorType dx = der.solve(value);
 
                 #ifdef CAPD_UTILS_LOG
 
@@ -60,6 +67,7 @@ public:
                 if (roots.is_present(new_root) == false)
                 {
                     root = new_root;
+                    state.save_search(i+1, root, roots);
                 }
                 else
                 {
@@ -73,6 +81,7 @@ public:
         }
 
         m_root = roots.best_argument();
+        state.finish();
     }
 
     const VectorType& get_root() const noexcept
@@ -102,11 +111,19 @@ public:
     using VectorType = typename MapT::VectorType;
     using MatrixType = typename MapT::MatrixType;
 
-    NewtonMethodInternal(MapT& map, const VectorType& initial_root, size_t max_steps)
+    NewtonMethodInternal(MapT& map, const VectorType& initial_root, size_t max_steps, Checkpoint* checkpoint)
     {
-        m_root_midpoint = find_root_midpoint(map, initial_root, max_steps);
-        m_root = m_root_midpoint;
-        m_successful = bound_solution(map, m_root, m_root_midpoint, max_steps);
+        NewtonMethodCheckpoint<MapT> state(checkpoint, map, initial_root);
+
+        size_t first_step = 0;
+        if (state.load_bound(first_step, m_root_midpoint, m_root) == false)
+        {
+            m_root_midpoint = find_root_midpoint(map, initial_root, max_steps, state);
+            m_root = m_root_midpoint;
+        }
+
+        m_successful = bound_solution(map, m_root, m_root_midpoint, first_step, max_steps, state);
+        state.finish();
     }
 
     const VectorType& get_root() const noexcept
@@ -125,16 +142,19 @@ public:
     }
 
 private:
-    static VectorType find_root_midpoint(MapT& map, const VectorType& initial_root, size_t max_steps)
+    static VectorType find_root_midpoint(MapT& map, const VectorType& initial_root, size_t max_steps, NewtonMethodCheckpoint<MapT>& state)
     {
-        MatrixType der( initial_root.dimension(), initial_root.dimension() );
+        NewtonMethodDerivative<MapT> der( initial_root.dimension() );
 
         MaxNorm<MapT> norm {};
         RootsList<MapT> roots {};
         Root<MapT> root {};
         root.argument = mid_vector( initial_root );
 
-        for (size_t i = 0;; ++i)
+        size_t first_step = 0;
+        state.load_search(first_step, root, roots);
+
+        for (size_t i = first_step;; ++i)
         {
             #ifdef CAPD_UTILS_LOG
 
@@ -142,14 +162,14 @@ private:
 
             #endif
 
-            const VectorType value = map(root.argument, der);
-            der = mid_matrix(der);
+            const VectorType value = der.evaluate(map, root.argument);
+            der.to_midpoint();
             root.value_norm = norm(value);
             roots.push_back(root);
 
             if (i < max_steps)
             {
-                const VectorType dx = mid_vector( gauss<MapT>(der, value) );
+                const VectorType dx = mid_vector( der.solve(value) );
 
                 #ifdef CAPD_UTILS_LOG
 
@@ -164,6 +184,7 @@ private:
                 if (roots.is_present(new_root) == false)
                 {
                     root = new_root;
+                    state.save_search(i+1, root, roots);
                 }
                 else
                 {
@@ -179,14 +200,22 @@ private:
         return roots.best_argument();
     }
 
-    bool bound_solution(MapT& map, VectorType& root, VectorType root_midpoint, size_t max_steps)
+    bool bound_solution(
+        MapT& map,
+        VectorType& root,
+        VectorType root_midpoint,
+        size_t first_step,
+        size_t max_steps,
+        NewtonMethodCheckpoint<MapT>& state)
     {
         if (subset(root_midpoint, root))
         {
             const VectorType val = map(root_midpoint);
 
-            for (size_t step = 0; step < max_steps; ++step)
+            for (size_t step = first_step; step < max_steps; ++step)
             {
+                state.save_bound(step, root_midpoint, root);
+
                 const VectorType interior = get_interior(map, root, root_midpoint, val);
 
                 #ifdef CAPD_UTILS_LOG
@@ -236,7 +265,18 @@ public:
     using MatrixType = typename MapT::MatrixType;
 
     NewtonMethod(MapT& map, const VectorType& initial_root, size_t max_steps) 
-        : m_internal(map, initial_root, max_steps)
+        : m_internal(map, initial_root, max_steps, nullptr)
+    {}
+
+    ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    //! @brief Constructor with checkpointing
+    //!
+    //! The state is saved into `checkpoint` during the computation. If `checkpoint` contains state of the computation
+    //! of the same map started from the same `initial_root`, the computation is resumed from that state. The checkpoint
+    //! is removed when the computation completes.
+    ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    NewtonMethod(MapT& map, const VectorType& initial_root, size_t max_steps, Checkpoint& checkpoint)
+        : m_internal(map, initial_root, max_steps, &checkpoint)
     {}
 
     const VectorType& get_root() const noexcept
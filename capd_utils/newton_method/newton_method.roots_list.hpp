@@ -24,22 +24,27 @@ struct RootsList : std::list<Root<MapT>>
     }
 
     VectorType best_argument() const
+    {
+        return best_root().argument;
+    }
+
+    Root<MapT> best_root() const
     {
         if (this->size() > 0)
         {
             auto it = this->begin();
 
-            Root<MapT> best_root = *it;
+            Root<MapT> ret = *it;
 
             for (++it; it != this->end(); ++it)
             {
-                if (it->value_norm < best_root.value_norm)
+                if (it->value_norm < ret.value_norm)
                 {
-                    best_root = *it;
+                    ret = *it;
                 }
             }
 
-            return best_root.argument;
+            return ret;
         }
         else
         {
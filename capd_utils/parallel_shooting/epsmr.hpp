@@ -6,6 +6,7 @@
 
 #include <memory>
 
+#include <capd_utils/block_sparse_matrix.hpp>
 #include <capd_utils/pne_map.hpp>
 #include <capd_utils/identity_map.hpp>
 #include <capd_utils/idx_list.hpp>
@@ -31,6 +32,7 @@ public:
     using ScalarType = typename MapT::ScalarType;
     using VectorType = typename MapT::VectorType;
     using MatrixType = typename MapT::MatrixType;
+    using SparseMatrixType = BlockSparseMatrix<MapT>;
 
     EPSMR(size_t n, MapF& map_f_ref, MapG& map_g_ref, MapH& map_h_ref)
         : m_n( check_size(n) )
@@ -111,32 +113,24 @@ public:
     VectorType operator() (const VectorType& vec, MatrixType& der) override
     {
         der = MatrixType( this->imageDimension(), this->dimension() );
+        return accumulate(vec, der);
+    }
 
-        VectorType ret( this->imageDimension() );
-        MatrixType tmp( this->imageDimension(), this->dimension() );
-
-        ret += (*m_pne_f)(vec, tmp);
-        der += tmp;
-
-        ret -= (*m_id_c_f)(vec, tmp);
-        der -= tmp;
-
-        for (auto & pne : m_pne_g)
+    ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    //! @brief Evaluate map with derivative stored as block sparse matrix (blocks are reused between calls)
+    ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    VectorType operator() (const VectorType& vec, SparseMatrixType& der)
+    {
+        if (der.dimension() == std::make_pair(this->imageDimension(), this->dimension()))
         {
-            ret += pne(vec, tmp);
-            der += tmp;
+            der.clear();
         }
-
-        for (auto & pne : m_id_c_g)
+        else
         {
-            ret -= pne(vec, tmp);
-            der -= tmp;
+            der = SparseMatrixType( this->imageDimension(), this->dimension() );
         }
 
-        ret += (*m_pne_h)(vec, tmp);
-        der += tmp;
-
-        return ret;
+        return accumulate(vec, der);
     }
 
     unsigned dimension() const noexcept override
@@ -150,6 +144,29 @@ public:
     }
 
 private:
+    template<typename DerT>
+    VectorType accumulate(const VectorType& vec, DerT& der)
+    {
+        VectorType ret( this->imageDimension() );
+
+        m_pne_f->accumulate(vec, ret, der, 1);
+        m_id_c_f->accumulate(vec, ret, der, -1);
+
+        for (auto & pne : m_pne_g)
+        {
+            pne.accumulate(vec, ret, der, 1);
+        }
+
+        for (auto & pne : m_id_c_g)
+        {
+            pne.accumulate(vec, ret, der, -1);
+        }
+
+        m_pne_h->accumulate(vec, ret, der, 1);
+
+        return ret;
+    }
+
     static size_t check_size(size_t n)
     {
         if (n >= 2)
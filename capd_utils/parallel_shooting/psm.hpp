@@ -4,6 +4,7 @@
 
 #pragma once
 
+#include <capd_utils/block_sparse_matrix.hpp>
 #include <capd_utils/pne_map.hpp>
 #include <capd_utils/identity_map.hpp>
 #include <capd_utils/idx_list.hpp>
@@ -27,6 +28,7 @@ public:
     using ScalarType = typename MapT::ScalarType;
     using VectorType = typename MapT::VectorType;
     using MatrixType = typename MapT::MatrixType;
+    using SparseMatrixType = BlockSparseMatrix<MapT>;
 
     PSM(size_t n, MapU& map_u)
         : m_n( check_size(n) )
@@ -75,23 +77,24 @@ public:
     VectorType operator() (const VectorType& vec, MatrixType& der) override
     {
         der = MatrixType( this->imageDimension(), this->dimension() );
+        return accumulate(vec, der);
+    }
 
-        VectorType ret( this->imageDimension() );
-        MatrixType tmp( this->imageDimension(), this->dimension() );
-
-        for (auto & pne : m_pne_container)
+    ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    //! @brief Evaluate map with derivative stored as block sparse matrix (blocks are reused between calls)
+    ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    VectorType operator() (const VectorType& vec, SparseMatrixType& der)
+    {
+        if (der.dimension() == std::make_pair(this->imageDimension(), this->dimension()))
         {
-            ret += pne(vec, tmp);
-            der += tmp;
+            der.clear();
         }
-
-        for (auto & pne : m_id_container)
+        else
         {
-            ret -= pne(vec, tmp);
-            der -= tmp;
+            der = SparseMatrixType( this->imageDimension(), this->dimension() );
         }
 
-        return ret;
+        return accumulate(vec, der);
     }
 
     unsigned dimension() const noexcept override
@@ -105,6 +108,24 @@ public:
     }
 
 private:
+    template<typename DerT>
+    VectorType accumulate(const VectorType& vec, DerT& der)
+    {
+        VectorType ret( this->imageDimension() );
+
+        for (auto & pne : m_pne_container)
+        {
+            pne.accumulate(vec, ret, der, 1);
+        }
+
+        for (auto & pne : m_id_container)
+        {
+            pne.accumulate(vec, ret, der, -1);
+        }
+
+        return ret;
+    }
+
     static size_t check_size(size_t n)
     {
         if (n > 0)
@@ -8,14 +8,20 @@
 #include "extension_map.hpp"
 #include "map_base.hpp"
 #include "map_compatibility.hpp"
+#include "block_sparse_matrix.hpp"
 
+#include <algorithm>
+#include <iterator>
 #include <stdexcept>
+#include <vector>
 
 namespace CapdUtils
 {
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 //! @brief Project and extend (PNE) map
+//!
+//! Projection and extension are evaluated by indices (see IndexProjectionMap and IndexExtensionMap).
 ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 template<typename MapT, typename MapU>
 class PNE : public MapBase<MapT>
@@ -41,8 +47,10 @@ public:
         const IdxList<int>& out_idx_list,
         MapUArgs... map_u_args)
             : m_map_u(map_u_args...)
-            , m_projection(ProjectionMap<MapT>::create(input_size, in_idx_list))
-            , m_extension(ExtensionMap<MapT>::create(out_idx_list))
+            , m_projection(input_size, in_idx_list)
+            , m_extension(out_idx_list)
+            , m_in_offset(get_in_offset(m_projection.indices()))
+            , m_out_offset(get_out_offset(m_extension.indices(), m_out_size))
     {
         if ( m_projection.imageDimension() != m_map_u.dimension() )
         {
@@ -59,32 +67,134 @@ public:
     {
         this->assert_vector_size(vec, m_projection.dimension(), "PNE vec vector size mismatch (1)!");
 
-        const VectorType v1 = m_projection(vec);
-        const VectorType v2 = m_map_u(v1);
-        const VectorType v3 = m_extension(v2);
+        VectorType ret( this->imageDimension() );
+        scatter_value(m_map_u(m_projection(vec)), ret, 1);
 
-        return v3;
+        return ret;
     }
 
     VectorType operator() (const VectorType& vec, MatrixType& mat) override
     {
         this->assert_vector_size(vec, m_projection.dimension(), "PNE vec vector size mismatch (2)!");
 
-        MatrixType m1(m_projection.imageDimension(), m_projection.dimension());
-        const VectorType v1 = m_projection(vec, m1);
-        this->assert_matrix_size(m1, m_projection.imageDimension(), m_projection.dimension(), "PNE m1 matrix size mismatch!");
+        assign_zero(mat, this->imageDimension(), this->dimension());
+
+        VectorType ret( this->imageDimension() );
+        accumulate(vec, ret, mat, 1);
+
+        return ret;
+    }
+
+    ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    //! @brief Add sign * PNE(vec) to `value` and sign * DPNE(vec) to `der`
+    //!
+    //! Projection and extension are applied by indices, so only entries of `der` in the rows of the extension and the
+    //! columns of the projection are touched. If the internal map is identity, its derivative is not evaluated at all.
+    ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    void accumulate(const VectorType& vec, VectorType& value, MatrixType& der, int sign)
+    {
+        this->assert_vector_size(vec, m_projection.dimension(), "PNE vec vector size mismatch (3)!");
+        this->assert_vector_size(value, m_extension.imageDimension(), "PNE value vector size mismatch!");
+        this->assert_matrix_size(der, m_extension.imageDimension(), m_projection.dimension(), "PNE der matrix size mismatch!");
+
+        const VectorType v1 = m_projection(vec);
+        const IdxList<size_t>& in_idx = m_projection.indices();
+        const IdxList<int>& out_idx = m_extension.indices();
+
+        if (get_jacobian_structure(m_map_u) == JacobianStructure::Identity)
+        {
+            scatter_value(m_map_u(v1), value, sign);
+
+            size_t r = 0;
+            for (const int& idx : out_idx)
+            {
+                if (idx >= 0)
+                {
+                    add(der(r+1, in_idx[idx]+1), ScalarType(1.0), sign);
+                }
+
+                ++r;
+            }
+        }
+        else
+        {
+            MatrixType m2(m_map_u.imageDimension(), m_map_u.dimension());
+            scatter_value(m_map_u(v1, m2), value, sign);
+            this->assert_matrix_size(m2, m_map_u.imageDimension(), m_map_u.dimension(), "PNE m2 matrix size mismatch!");
+
+            size_t r = 0;
+            for (const int& idx : out_idx)
+            {
+                if (idx >= 0)
+                {
+                    size_t c = 0;
+                    for (const size_t& col : in_idx)
+                    {
+                        add(der(r+1, col+1), m2(idx+1, c+1), sign);
+                        ++c;
+                    }
+                }
+
+                ++r;
+            }
+        }
+    }
+
+    ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    //! @brief Add sign * PNE(vec) to `value` and sign * DPNE(vec) to `der` as a single block
+    //!
+    //! Requires index lists selecting contiguous ranges, i.e. (a, a+1, ..., a+k-1) for the projection and
+    //! (-1, ..., -1, 0, 1, ..., m-1, -1, ..., -1) for the extension.
+    ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    void accumulate(const VectorType& vec, VectorType& value, BlockSparseMatrix<MapT>& der, int sign)
+    {
+        this->assert_vector_size(vec, m_projection.dimension(), "PNE vec vector size mismatch (4)!");
+        this->assert_vector_size(value, m_extension.imageDimension(), "PNE value vector size mismatch (2)!");
+
+        if (der.dimension() != std::make_pair(this->imageDimension(), this->dimension()))
+        {
+            throw std::logic_error("PNE der sparse matrix size mismatch!");
+        }
+
+        if (m_in_offset < 0 || m_out_offset < 0)
+        {
+            throw std::logic_error("PNE: sparse derivative requires contiguous index lists!");
+        }
+
+        const unsigned rows = m_out_size;
+        const unsigned cols = m_projection.imageDimension();
+        MatrixType& block = der.block(m_out_offset, m_in_offset, rows, cols);
 
-        MatrixType m2(m_map_u.imageDimension(), m_map_u.dimension());
-        const VectorType v2 = m_map_u(v1, m2);
-        this->assert_matrix_size(m2, m_map_u.imageDimension(), m_map_u.dimension(), "PNE m2 matrix size mismatch!");
+        const VectorType v1 = m_projection(vec);
 
-        MatrixType m3(m_extension.imageDimension(), m_extension.dimension());
-        const VectorType v3 = m_extension(v2, m3);
-        this->assert_matrix_size(m3, m_extension.imageDimension(), m_extension.dimension(), "PNE m3 matrix size mismatch!");
+        if (get_jacobian_structure(m_map_u) == JacobianStructure::Identity)
+        {
+            scatter_value(m_map_u(v1), value, sign);
 
-        mat = m3 * m2 * m1;
+            for (unsigned r = 1; r <= rows; ++r)
+            {
+                add(block(r, r), ScalarType(1.0), sign);
+            }
+        }
+        else
+        {
+            MatrixType m2(m_map_u.imageDimension(), m_map_u.dimension());
+            scatter_value(m_map_u(v1, m2), value, sign);
+            this->assert_matrix_size(m2, m_map_u.imageDimension(), m_map_u.dimension(), "PNE m2 matrix size mismatch (2)!");
 
-        return v3;
+            for (unsigned r = 1; r <= rows; ++r)
+            {
+                for (unsigned c = 1; c <= cols; ++c)
+                {
+                    add(block(r, c), m2(r, c), sign);
+                }
+            }
+        }
+    }
+
+    JacobianStructure jacobian_structure() const noexcept override
+    {
+        return JacobianStructure::Sparse;
     }
 
     unsigned dimension() const noexcept override
@@ -98,13 +208,71 @@ public:
     }
 
     MapU & internal_map() noexcept { return m_map_u; }
-    MapT & extend() noexcept { return m_extension; }
-    MapT & project() noexcept { return m_projection; }
+    IndexExtensionMap<MapT> & extend() noexcept { return m_extension; }
+    IndexProjectionMap<MapT> & project() noexcept { return m_projection; }
 
 private:
     MapU m_map_u;
-    MapT m_projection;
-    MapT m_extension;
+    IndexProjectionMap<MapT> m_projection;
+    IndexExtensionMap<MapT> m_extension;
+
+    //! Offsets of contiguous index ranges (-1 if index list is not contiguous)
+    unsigned m_out_size {};
+    const int m_in_offset;
+    const int m_out_offset;
+
+    static int get_in_offset(const IdxList<size_t>& idx)
+    {
+        // consecutive indices are merged into a single run
+        const auto& runs = idx.runs();
+        const bool is_contiguous = runs.size() == 1 && (runs[0].step == 1 || runs[0].length == 1);
+
+        return is_contiguous ? static_cast<int>(runs[0].first) : -1;
+    }
+
+    static int get_out_offset(const IdxList<int>& idx, unsigned& size)
+    {
+        const auto first = std::find_if(idx.begin(), idx.end(), [](int i) { return i >= 0; });
+        const int offset = std::distance(idx.begin(), first);
+
+        size = 0;
+        for (auto it = first; it != idx.end() && *it >= 0; ++it, ++size)
+        {
+            if (*it != static_cast<int>(size))
+            {
+                return -1;
+            }
+        }
+
+        const bool tail_is_empty = std::all_of(std::next(first, size), idx.end(), [](int i) { return i < 0; });
+        return (size > 0 && tail_is_empty) ? offset : -1;
+    }
+
+    void scatter_value(const VectorType& v2, VectorType& value, int sign) const
+    {
+        size_t r = 0;
+        for (const int& idx : m_extension.indices())
+        {
+            if (idx >= 0)
+            {
+                add(value[r], v2[idx], sign);
+            }
+
+            ++r;
+        }
+    }
+
+    static void add(ScalarType& target, const ScalarType& arg, int sign)
+    {
+        if (sign < 0)
+        {
+            target -= arg;
+        }
+        else
+        {
+            target += arg;
+        }
+    }
 };
 
 }
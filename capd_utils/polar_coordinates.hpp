@@ -4,6 +4,8 @@
 
 #pragma once
 
+#include <cmath>
+
 #include "map_base.hpp"
 #include "arctan2_map.hpp"
 
@@ -37,6 +39,8 @@ private:
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 //! @brief (x,y) -> (r,alpha)
+//!
+//! Value and derivative are computed in closed form, alpha as in Arctan2.
 ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 template<typename MapT>
 class PolarCoordinatesInverse : public MapBase<MapT>
@@ -46,33 +50,32 @@ public:
     using VectorType = typename MapT::VectorType;
     using MatrixType = typename MapT::MatrixType;
 
-    PolarCoordinatesInverse()
-        : m_map_r(func, 2, 1, 0)
-        , m_map_alpha()
-    {}
-
     VectorType operator() (const VectorType& vec) override
     {
         this->assert_vector_size(vec, 2, "PolarCoordinatesInverse vec vector size mismatch (1)!");
 
-        const VectorType ret_r = m_map_r(vec);
-        const VectorType ret_alpha = m_map_alpha(vec);
+        using std::sqrt;
 
-        return VectorType{ ret_r[0], ret_alpha[0] };
+        const ScalarType& x = vec[0];
+        const ScalarType& y = vec[1];
+
+        return VectorType{ sqrt(square(x) + square(y)), Arctan2<MapT>::evaluate(x, y) };
     }
 
     VectorType operator() (const VectorType& vec, MatrixType& mat) override
     {
         this->assert_vector_size(vec, 2, "PolarCoordinatesInverse vec vector size mismatch (2)!");
 
-        MatrixType mat_r(1, 2);
-        const VectorType ret_r = m_map_r(vec, mat_r);
+        using std::sqrt;
+
+        const ScalarType& x = vec[0];
+        const ScalarType& y = vec[1];
 
-        MatrixType mat_alpha(1, 2);
-        const VectorType ret_alpha = m_map_alpha(vec, mat_alpha);
+        const ScalarType r2 = square(x) + square(y);
+        const ScalarType r = sqrt(r2);
 
-        mat = MatrixType{ { mat_r(1, 1), mat_r(1, 2) }, { mat_alpha(1, 1), mat_alpha(1, 2) } };
-        return VectorType{ ret_r[0], ret_alpha[0] };
+        mat = MatrixType{ { x / r, y / r }, { -y / r2, x / r2 } };
+        return VectorType{ r, Arctan2<MapT>::evaluate(x, y) };
     }
 
     unsigned dimension() const noexcept override
@@ -84,18 +87,6 @@ public:
     {
         return 2;
     }
-
-private:
-    static void func(Node, Node in[], int, Node out[], int, Node param[], int)
-    {
-        Node& x = in[0];
-        Node& y = in[1];
-
-        out[0] = sqrt(sqr(x) + sqr(y));
-    }
-
-    MapT m_map_r;
-    Arctan2<MapT> m_map_alpha;
 };
 
 }
@@ -6,9 +6,11 @@
 
 #include <list>
 #include <stdexcept>
+#include <vector>
 
 #include "capd/basic_types.hpp"
 #include "idx_list.hpp"
+#include "map_base.hpp"
 
 namespace CapdUtils
 {
@@ -62,4 +64,112 @@ public:
     }
 };
 
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//! @brief Projection map evaluated by indices
+//!
+//! @details Equivalent of the map created by ProjectionMap::create without automatic differentiation: value is
+//!          gathered in O(k) for k output indices and the derivative is constant 0/1 matrix with single 1 in each row.
+//!          Indices are kept as runs of IdxList, so the map takes constant memory for lists made by IdxList::create.
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+template<typename MapT>
+class IndexProjectionMap : public MapBase<MapT>
+{
+public:
+    using ScalarType = typename MapT::ScalarType;
+    using VectorType = typename MapT::VectorType;
+    using MatrixType = typename MapT::MatrixType;
+
+    ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    //! @brief Constructor
+    //!
+    //! @param input_size dimension of map input
+    //! @param idx_list   list of indices specifying output (see ProjectionMap::create)
+    ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    IndexProjectionMap(size_t input_size, const IdxList<size_t>& idx_list)
+        : m_input_size(input_size)
+        , m_idx(idx_list)
+    {
+        if (m_idx.empty())
+        {
+            throw std::logic_error("Index list is empty!");
+        }
+
+        // indices in runs are non-decreasing, so the last one is the largest
+        for (const Run& run : m_idx.runs())
+        {
+            if (run.first + (run.length - 1) * run.step >= input_size)
+            {
+                throw std::logic_error("Index is out of range!");
+            }
+        }
+    }
+
+    VectorType operator() (const VectorType& vec) override
+    {
+        this->assert_vector_size(vec, m_input_size, "IndexProjectionMap vec vector size mismatch (1)!");
+
+        VectorType ret( m_idx.size() );
+
+        size_t i = 0;
+        for (const Run& run : m_idx.runs())
+        {
+            for (size_t k = 0; k < run.length; ++k, ++i)
+            {
+                ret[i] = vec[run.first + k * run.step];
+            }
+        }
+
+        return ret;
+    }
+
+    VectorType operator() (const VectorType& vec, MatrixType& mat) override
+    {
+        this->assert_vector_size(vec, m_input_size, "IndexProjectionMap vec vector size mismatch (2)!");
+
+        assign_zero(mat, this->imageDimension(), this->dimension());
+
+        VectorType ret( m_idx.size() );
+
+        size_t i = 0;
+        for (const Run& run : m_idx.runs())
+        {
+            for (size_t k = 0; k < run.length; ++k, ++i)
+            {
+                const size_t idx = run.first + k * run.step;
+                ret[i] = vec[idx];
+                mat(i+1, idx+1) = 1.0;
+            }
+        }
+
+        return ret;
+    }
+
+    unsigned dimension() const noexcept override
+    {
+        return m_input_size;
+    }
+
+    unsigned imageDimension() const noexcept override
+    {
+        return m_idx.size();
+    }
+
+    JacobianStructure jacobian_structure() const noexcept override
+    {
+        return JacobianStructure::Sparse;
+    }
+
+    //! Input index of each output
+    const IdxList<size_t>& indices() const noexcept
+    {
+        return m_idx;
+    }
+
+private:
+    using Run = typename IdxList<size_t>::Run;
+
+    size_t m_input_size;
+    IdxList<size_t> m_idx;
+};
+
 }
@@ -4,8 +4,12 @@
 
 #pragma once
 
+#include <array>
+#include <cstdint>
 #include <iomanip>
 #include <ostream>
+#include <sstream>
+#include <string>
 
 namespace CapdUtils
 {
@@ -15,14 +19,16 @@ class ReadableMemory
 public:
 	static std::ostream& print_hex(std::ostream& ostr, const void* ptr, std::size_t len)
 	{
-		while (len > 0)
+		std::string buffer(2 * len, '0');
+
+		for (std::size_t i = 0; len > 0; i += 2)
 		{
 			const uint16_t value = static_cast<const uint8_t*>(ptr)[--len];
-			ostr << to_char((value >> 4) & 0xf);
-			ostr << to_char(value & 0xf);
+			buffer[i] = to_char((value >> 4) & 0xf);
+			buffer[i+1] = to_char(value & 0xf);
 		}
 
-		return ostr;
+		return ostr.write(buffer.data(), buffer.size());
 	}
 
 	static std::istream& parse_hex(std::istream& istr, void* ptr, std::size_t len)
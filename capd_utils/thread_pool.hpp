@@ -0,0 +1,211 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Author: Aleksander M. Pasiut
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace CapdUtils
+{
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//! @brief Minimal thread pool executing batches of indexed tasks
+//!
+//! @details `run(tasks, func)` calls func(0), ..., func(tasks-1) on the workers and the calling thread, and returns when
+//!          all calls are finished. The first exception thrown by func is rethrown by `run`.
+//!
+//!          The pool executes single batch at a time. Nested batch (submitted by a task of this pool, e.g. through a copy
+//!          of ParallelExecution) and batch submitted while other thread's batch is running are executed inline by the
+//!          calling thread, so the pool never blocks waiting for itself.
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+class ThreadPool
+{
+public:
+    ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    //! @brief Constructor
+    //!
+    //! @param threads total number of threads executing tasks (including the calling thread)
+    ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    explicit ThreadPool(unsigned threads)
+    {
+        for (unsigned t = 1; t < threads; ++t)
+        {
+            m_workers.emplace_back([this]() { work(); });
+        }
+    }
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    ~ThreadPool()
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_stop = true;
+        }
+
+        m_work_cv.notify_all();
+
+        for (std::thread& worker : m_workers)
+        {
+            worker.join();
+        }
+    }
+
+    void run(size_t tasks, const std::function<void(size_t)>& func)
+    {
+        if (is_executing_task())
+        {
+            run_inline(tasks, func);
+            return;
+        }
+
+        std::unique_lock<std::mutex> batch_lock(m_batch_mutex, std::try_to_lock);
+
+        if (!batch_lock.owns_lock())
+        {
+            run_inline(tasks, func);
+            return;
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_func = &func;
+            m_tasks = tasks;
+            m_next = 0;
+            m_done = 0;
+            m_error = nullptr;
+        }
+
+        m_work_cv.notify_all();
+
+        std::unique_lock<std::mutex> lock(m_mutex);
+        execute(lock);
+        m_done_cv.wait(lock, [this]() { return m_done == m_tasks; });
+
+        m_func = nullptr;
+
+        if (m_error)
+        {
+            std::rethrow_exception(m_error);
+        }
+    }
+
+    size_t size() const noexcept
+    {
+        return m_workers.size() + 1;
+    }
+
+private:
+    //! Pools whose tasks are executed by the current thread (innermost first)
+    struct TaskFrame
+    {
+        const ThreadPool* pool;
+        const TaskFrame* previous;
+    };
+
+    static const TaskFrame*& current_frame()
+    {
+        static thread_local const TaskFrame* frame = nullptr;
+        return frame;
+    }
+
+    bool is_executing_task() const
+    {
+        for (const TaskFrame* frame = current_frame(); frame; frame = frame->previous)
+        {
+            if (frame->pool == this)
+            {
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    static void run_inline(size_t tasks, const std::function<void(size_t)>& func)
+    {
+        for (size_t i = 0; i < tasks; ++i)
+        {
+            func(i);
+        }
+    }
+
+    void work()
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+
+        while (true)
+        {
+            m_work_cv.wait(lock, [this]() { return m_stop || m_next < m_tasks; });
+
+            if (m_stop)
+            {
+                return;
+            }
+
+            execute(lock);
+        }
+    }
+
+    //! Execute tasks of current batch until none is left (`lock` is held on entry and exit)
+    void execute(std::unique_lock<std::mutex>& lock)
+    {
+        while (m_next < m_tasks)
+        {
+            const size_t index = m_next++;
+            const std::function<void(size_t)>& func = *m_func;
+
+            lock.unlock();
+
+            const TaskFrame frame { this, current_frame() };
+            current_frame() = &frame;
+
+            std::exception_ptr error {};
+            try
+            {
+                func(index);
+            }
+            catch (...)
+            {
+                error = std::current_exception();
+            }
+
+            current_frame() = frame.previous;
+
+            lock.lock();
+
+            if (error && !m_error)
+            {
+                m_error = error;
+            }
+
+            if (++m_done == m_tasks)
+            {
+                m_done_cv.notify_all();
+            }
+        }
+    }
+
+    std::vector<std::thread> m_workers {};
+
+    std::mutex m_batch_mutex {};
+    std::mutex m_mutex {};
+    std::condition_variable m_work_cv {};
+    std::condition_variable m_done_cv {};
+
+    const std::function<void(size_t)>* m_func = nullptr;
+    size_t m_tasks = 0;
+    size_t m_next = 0;
+    size_t m_done = 0;
+    std::exception_ptr m_error {};
+    bool m_stop = false;
+};
+
+}
@@ -0,0 +1,169 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Author: Aleksander M. Pasiut
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//! @brief Sparse solver of BlockSparseMatrix compared with dense Gauss elimination (see capd_utils/block_sparse_matrix.hpp)
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <stdexcept>
+
+#include <capd_utils/block_sparse_matrix.hpp>
+#include <capd_utils/capd/gauss_solver.hpp>
+#include <capd_utils/capd/map.hpp>
+
+#include "test_utils.hpp"
+
+namespace
+{
+
+using namespace CapdUtils;
+
+//! Maximal absolute difference of entries
+double distance(const RVector& a, const RVector& b)
+{
+    double ret = 0.0;
+    for (unsigned i = 0; i < a.dimension(); ++i)
+    {
+        ret = std::max(ret, std::abs(a[i] - b[i]));
+    }
+
+    return ret;
+}
+
+RVector get_rhs(unsigned dimension, std::mt19937& generator)
+{
+    std::uniform_real_distribution<double> distribution(-1.0, 1.0);
+
+    RVector ret(dimension);
+    for (unsigned i = 0; i < dimension; ++i)
+    {
+        ret[i] = distribution(generator);
+    }
+
+    return ret;
+}
+
+//! Jacobian of cyclic parallel shooting map: row block i is (.., D_i at column block i, -I at column block i+1 mod n, ..)
+BlockSparseMatrix<RMap> get_cpsm_matrix(unsigned segments, unsigned n, std::mt19937& generator)
+{
+    std::uniform_real_distribution<double> distribution(-2.0, 2.0);
+
+    BlockSparseMatrix<RMap> ret(segments * n, segments * n);
+
+    for (unsigned s = 0; s < segments; ++s)
+    {
+        RMatrix& D = ret.block(s * n, s * n, n, n);
+        for (unsigned i = 1; i <= n; ++i)
+        {
+            for (unsigned j = 1; j <= n; ++j)
+            {
+                D(i, j) = distribution(generator);
+            }
+        }
+
+        // zero leading entries force row exchanges
+        D(1, 1) = 0.0;
+
+        RMatrix& minus_identity = ret.block(s * n, ((s + 1) % segments) * n, n, n);
+        for (unsigned i = 1; i <= n; ++i)
+        {
+            minus_identity(i, i) = -1.0;
+        }
+    }
+
+    return ret;
+}
+
+void test_cyclic_block_bidiagonal()
+{
+    std::mt19937 generator(2024);
+
+    for (unsigned segments : { 2u, 3u, 8u })
+    {
+        for (unsigned n : { 1u, 2u, 4u })
+        {
+            const BlockSparseMatrix<RMap> A = get_cpsm_matrix(segments, n, generator);
+            const RVector b = get_rhs(segments * n, generator);
+
+            const RVector sparse = A.solve(b);
+            const RVector dense = gauss<RMap>(A.to_dense(), b);
+
+            CAPD_UTILS_CHECK(distance(sparse, dense) < 1e-9);
+            CAPD_UTILS_CHECK(distance(A * sparse, b) < 1e-9);
+        }
+    }
+}
+
+void test_pivoting()
+{
+    // the natural pivot is zero in each column and the matrix is a permutation of triangular one
+    BlockSparseMatrix<RMap> A(3, 3);
+    A.block(0, 1, 1, 2)(1, 1) = 2.0;
+    A.block(1, 0, 1, 1)(1, 1) = 4.0;
+    A.block(2, 2, 1, 1)(1, 1) = 3.0;
+    A.block(1, 2, 1, 1)(1, 1) = 1.0;
+
+    RVector b(3);
+    b[0] = 2.0;
+    b[1] = 9.0;
+    b[2] = 6.0;
+
+    const RVector x = A.solve(b);
+
+    CAPD_UTILS_CHECK(std::abs(x[0] - 1.75) < 1e-14);
+    CAPD_UTILS_CHECK(std::abs(x[1] - 1.0) < 1e-14);
+    CAPD_UTILS_CHECK(std::abs(x[2] - 2.0) < 1e-14);
+}
+
+void test_overlapping_blocks()
+{
+    std::mt19937 generator(7);
+
+    BlockSparseMatrix<RMap> A = get_cpsm_matrix(3, 2, generator);
+    A.block(1, 1, 2, 2)(1, 1) += 5.0;
+    A.block(1, 1, 2, 2)(2, 2) += 5.0;
+
+    const RVector b = get_rhs(6, generator);
+
+    CAPD_UTILS_CHECK(distance(A.solve(b), gauss<RMap>(A.to_dense(), b)) < 1e-9);
+}
+
+void test_singular()
+{
+    BlockSparseMatrix<RMap> A(4, 4);
+    RMatrix& block = A.block(0, 0, 4, 2);
+    for (unsigned i = 1; i <= 4; ++i)
+    {
+        block(i, 1) = i;
+        block(i, 2) = 2.0 * i;
+    }
+
+    bool thrown = false;
+
+    try
+    {
+        A.solve(RVector(4));
+    }
+    catch (const std::runtime_error&)
+    {
+        thrown = true;
+    }
+
+    CAPD_UTILS_CHECK(thrown);
+}
+
+}
+
+int main()
+{
+    CapdUtilsTests::run_test("cyclic_block_bidiagonal", test_cyclic_block_bidiagonal);
+    CapdUtilsTests::run_test("pivoting", test_pivoting);
+    CapdUtilsTests::run_test("overlapping_blocks", test_overlapping_blocks);
+    CapdUtilsTests::run_test("singular", test_singular);
+
+    return CapdUtilsTests::report();
+}
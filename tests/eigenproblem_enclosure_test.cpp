@@ -0,0 +1,116 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Author: Aleksander M. Pasiut
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//! @brief Enclosure of eigenpairs by EigenproblemEnclosure (see capd_utils/eigenproblem.enclosure.hpp)
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <stdexcept>
+#include <vector>
+
+#include <capd_utils/capd/map.hpp>
+#include <capd_utils/eigenproblem.enclosure.hpp>
+#include <capd_utils/eigenproblem.hessenberg_qr.hpp>
+#include <capd_utils/type_cast.hpp>
+
+#include "test_utils.hpp"
+
+namespace
+{
+
+using namespace CapdUtils;
+
+//! Upper triangular matrix with eigenvalues 1, 4, 6
+IMatrix get_triangular_matrix()
+{
+    IMatrix ret(3, 3);
+    ret(1, 1) = 1.0; ret(1, 2) = 2.0; ret(1, 3) = 3.0;
+    ret(2, 2) = 4.0; ret(2, 3) = 5.0;
+    ret(3, 3) = 6.0;
+    return ret;
+}
+
+//! Enclose all eigenpairs of `arg` starting from approximations computed by HessenbergQR
+std::vector<Eigenpair<IMap>> enclose(const IMatrix& arg)
+{
+    const HessenbergQR solver( matrix_cast<RMatrix>(arg) );
+    const std::vector<Real> lambdas = solver.get_real_eigenvalues();
+    const unsigned n = arg.numberOfRows();
+
+    IMatrix similarity_matrix(n, n);
+    IMatrix eigenvalues_matrix(n, n);
+
+    for (unsigned j = 1; j <= n; ++j)
+    {
+        const RVector x = solver.get_eigenvector(lambdas.at(j-1));
+
+        for (unsigned i = 1; i <= n; ++i)
+        {
+            similarity_matrix(i, j) = x(i);
+        }
+
+        eigenvalues_matrix(j, j) = lambdas.at(j-1);
+    }
+
+    return EigenproblemEnclosure<IMap>(arg).enclose(similarity_matrix, eigenvalues_matrix, 10);
+}
+
+void test_eigenvalues()
+{
+    const std::vector<Eigenpair<IMap>> eigenpairs = enclose( get_triangular_matrix() );
+    CAPD_UTILS_CHECK(eigenpairs.size() == 3);
+
+    for (const Eigenpair<IMap>& eigenpair : eigenpairs)
+    {
+        const Interval& lambda = eigenpair.get_lambda();
+
+        const bool contains_exact = lambda.contains(1.0) || lambda.contains(4.0) || lambda.contains(6.0);
+        CAPD_UTILS_CHECK(contains_exact);
+        CAPD_UTILS_CHECK(lambda.rightBound() - lambda.leftBound() < 1e-10);
+    }
+}
+
+void test_eigenvectors()
+{
+    const IMatrix arg = get_triangular_matrix();
+
+    for (const Eigenpair<IMap>& eigenpair : enclose(arg))
+    {
+        const IVector& x = eigenpair.get_vector();
+        const IVector residual = arg * x - eigenpair.get_lambda() * x;
+
+        for (unsigned i = 0; i < residual.dimension(); ++i)
+        {
+            CAPD_UTILS_CHECK(residual[i].contains(0.0));
+            CAPD_UTILS_CHECK(residual[i].rightBound() - residual[i].leftBound() < 1e-8);
+        }
+    }
+}
+
+void test_multiple_eigenvalue()
+{
+    bool thrown = false;
+
+    try
+    {
+        enclose( IMatrix::Identity(3) );
+    }
+    catch (const std::runtime_error&)
+    {
+        thrown = true;
+    }
+
+    CAPD_UTILS_CHECK(thrown);
+}
+
+}
+
+int main()
+{
+    CapdUtilsTests::run_test("eigenvalues", test_eigenvalues);
+    CapdUtilsTests::run_test("eigenvectors", test_eigenvectors);
+    CapdUtilsTests::run_test("multiple_eigenvalue", test_multiple_eigenvalue);
+
+    return CapdUtilsTests::report();
+}
@@ -0,0 +1,149 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Author: Aleksander M. Pasiut
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//! @brief Contract of FenvCheckedRounding / FenvRoundingGuard (see capd_utils/capd/fenv_rounding.hpp)
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <cstdio>
+#include <vector>
+
+#include <capd_utils/capd/basic_types.hpp>
+#include <capd_utils/execution_policy.hpp>
+
+#include "test_utils.hpp"
+
+#ifdef __HAVE_LONG__
+
+namespace
+{
+
+using namespace CapdUtils;
+using capd::rounding::FenvCheckedRounding;
+using capd::rounding::FenvRoundingGuard;
+using capd::rounding::RoundingMode;
+
+//! Long double intervals switching the rounding mode by the policy under test
+using LCInterval = capd::intervals::Interval<LReal, FenvCheckedRounding>;
+
+//! Enclosure of 1/k must have distinct bounds bracketing 1/k (k not a power of two)
+template<typename IntervalT>
+bool is_rigorous_reciprocal(int k)
+{
+    const IntervalT x = IntervalT(1.0) / IntervalT(k);
+
+    // Exact products of bounds with k are compared in long double arithmetic with directed rounding
+    FenvRoundingGuard up(RoundingMode::RoundUp);
+    const bool left_ok = x.leftBound() * k <= 1.0L;
+
+    FenvRoundingGuard down(RoundingMode::RoundDown);
+    const bool right_ok = x.rightBound() * k >= 1.0L;
+
+    return x.leftBound() < x.rightBound() && left_ok && right_ok;
+}
+
+void test_is_working()
+{
+    FenvRoundingGuard guard;
+    CAPD_UTILS_CHECK(FenvCheckedRounding::isWorking());
+}
+
+void test_external_mode_change()
+{
+    FenvRoundingGuard guard;
+
+    FenvCheckedRounding::roundUp();
+    fesetround(FE_DOWNWARD);
+
+    FenvCheckedRounding::roundUp();
+    CAPD_UTILS_CHECK(fegetround() == FE_UPWARD);
+
+    FenvCheckedRounding::roundDown();
+    fesetround(FE_TONEAREST);
+
+    FenvCheckedRounding::roundDown();
+    CAPD_UTILS_CHECK(fegetround() == FE_DOWNWARD);
+}
+
+void test_guard_restores_mode()
+{
+    fesetround(FE_TONEAREST);
+
+    {
+        FenvRoundingGuard guard(RoundingMode::RoundUp);
+        CAPD_UTILS_CHECK(fegetround() == FE_UPWARD);
+
+        FenvCheckedRounding::roundDown();
+        CAPD_UTILS_CHECK(fegetround() == FE_DOWNWARD);
+    }
+
+    CAPD_UTILS_CHECK(fegetround() == FE_TONEAREST);
+}
+
+void test_intervals_after_external_mode_change()
+{
+    FenvRoundingGuard guard;
+
+    for (int k = 3; k < 50; k += 2)
+    {
+        fesetround(k % 3 == 0 ? FE_TONEAREST : FE_UPWARD);
+        CAPD_UTILS_CHECK(is_rigorous_reciprocal<LCInterval>(k));
+
+        fesetround(k % 3 == 0 ? FE_UPWARD : FE_DOWNWARD);
+        CAPD_UTILS_CHECK(is_rigorous_reciprocal<LUInterval>(k));
+
+        // double precision intervals switch the mode by other rounding policy
+        const Interval d = Interval(1.0) / Interval(k);
+        CAPD_UTILS_CHECK(d.leftBound() < d.rightBound());
+
+        CAPD_UTILS_CHECK(is_rigorous_reciprocal<LCInterval>(k));
+    }
+}
+
+void test_thread_pool()
+{
+    const size_t tasks = 256;
+    std::vector<char> results(tasks, 0);
+
+    ParallelExecution policy(4);
+    policy.run(tasks, [&](size_t i)
+    {
+        FenvRoundingGuard guard;
+
+        // other code running in the worker leaves arbitrary rounding mode
+        const int modes[] = { FE_TONEAREST, FE_UPWARD, FE_DOWNWARD, FE_TOWARDZERO };
+        fesetround(modes[i % 4]);
+
+        const int k = 3 + 2 * static_cast<int>(i);
+        results[i] = is_rigorous_reciprocal<LCInterval>(k) && is_rigorous_reciprocal<LUInterval>(k);
+    });
+
+    for (size_t i = 0; i < tasks; ++i)
+    {
+        CAPD_UTILS_CHECK(results[i]);
+    }
+}
+
+}
+
+int main()
+{
+    CapdUtilsTests::run_test("is_working", test_is_working);
+    CapdUtilsTests::run_test("external_mode_change", test_external_mode_change);
+    CapdUtilsTests::run_test("guard_restores_mode", test_guard_restores_mode);
+    CapdUtilsTests::run_test("intervals_after_external_mode_change", test_intervals_after_external_mode_change);
+    CapdUtilsTests::run_test("thread_pool", test_thread_pool);
+
+    return CapdUtilsTests::report();
+}
+
+#else
+
+int main()
+{
+    std::printf("long double intervals are not available (__HAVE_LONG__ is not defined), skipped\n");
+    return 0;
+}
+
+#endif
@@ -0,0 +1,162 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Author: Aleksander M. Pasiut
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//! @brief Run representation, random access and equality of IdxList (see capd_utils/idx_list.hpp)
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <cstddef>
+#include <stdexcept>
+#include <vector>
+
+#include <capd_utils/idx_list.hpp>
+
+#include "test_utils.hpp"
+
+namespace
+{
+
+using namespace CapdUtils;
+
+//! Iteration, random access and size of `list` agree with `expected`
+template<typename IdxT>
+bool matches(const IdxList<IdxT>& list, const std::vector<IdxT>& expected)
+{
+    if (list.size() != expected.size() || list.empty() != expected.empty())
+    {
+        return false;
+    }
+
+    const std::vector<IdxT> iterated(list.begin(), list.end());
+    if (iterated != expected)
+    {
+        return false;
+    }
+
+    for (size_t i = 0; i < expected.size(); ++i)
+    {
+        if (list[i] != expected[i] || list.at(i) != expected[i])
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+void test_create_range()
+{
+    const IdxList<size_t> list = IdxList<size_t>::create(4, 5);
+
+    CAPD_UTILS_CHECK(matches(list, std::vector<size_t>{ 4, 5, 6, 7, 8 }));
+    CAPD_UTILS_CHECK(list.runs().size() == 1);
+
+    // constant memory regardless of the size
+    const IdxList<size_t> large = IdxList<size_t>::create(10, 1000000);
+    CAPD_UTILS_CHECK(large.runs().size() == 1);
+    CAPD_UTILS_CHECK(large.size() == 1000000);
+    CAPD_UTILS_CHECK(large[0] == 10 && large[123456] == 123466 && large[999999] == 1000009);
+}
+
+void test_create_embedded()
+{
+    const IdxList<int> list = IdxList<int>::create(7, 2, 3);
+
+    CAPD_UTILS_CHECK(matches(list, std::vector<int>{ -1, -1, 0, 1, 2, -1, -1 }));
+    CAPD_UTILS_CHECK(list.runs().size() == 3);
+
+    // empty fill runs are not stored
+    const IdxList<int> leading = IdxList<int>::create(3, 0, 3);
+    CAPD_UTILS_CHECK(matches(leading, std::vector<int>{ 0, 1, 2 }));
+    CAPD_UTILS_CHECK(leading.runs().size() == 1);
+
+    const IdxList<int> shifted = IdxList<int>::create(5, 1, 2, 3, -2);
+    CAPD_UTILS_CHECK(matches(shifted, std::vector<int>{ -2, 3, 4, -2, -2 }));
+
+    // range exceeding total size is not truncated
+    const IdxList<int> overflow = IdxList<int>::create(3, 2, 2);
+    CAPD_UTILS_CHECK(matches(overflow, std::vector<int>{ -1, -1, 0, 1 }));
+}
+
+void test_push_back()
+{
+    const std::vector<std::vector<int>> sequences
+    {
+        { -1, 1, 0, -1, -1 },
+        { -1, 0, 1, 2, -1 },
+        { -1, 0, 1, -1, 0, 0, 1 },
+        { 0, 0, 0, 1, 2, 2, 1, 0 },
+        { 1, 0, -1, -1, 0, 1 },
+        { 5 },
+        {}
+    };
+
+    for (const std::vector<int>& sequence : sequences)
+    {
+        IdxList<int> pushed {};
+        for (int idx : sequence)
+        {
+            pushed.push_back(idx);
+        }
+
+        CAPD_UTILS_CHECK(matches(pushed, sequence));
+        CAPD_UTILS_CHECK(matches(IdxList<int>(sequence.begin(), sequence.end()), sequence));
+    }
+
+    // range (-1, 0, 1) followed by fills (-1, -1), (0, 0) and (1)
+    IdxList<int> list { -1, 0, 1, -1, -1, 0, 0, 1 };
+    CAPD_UTILS_CHECK(list.runs().size() == 4);
+
+    // consecutive and repeated indices extend the last run
+    const IdxList<int> fill { 3, 3, 3, 3 };
+    CAPD_UTILS_CHECK(fill.runs().size() == 1);
+    CAPD_UTILS_CHECK(matches(fill, std::vector<int>{ 3, 3, 3, 3 }));
+}
+
+void test_equality()
+{
+    // the same indices stored in different runs
+    const IdxList<int> created = IdxList<int>::create(3, 1, 2);
+    const IdxList<int> pushed { -1, 0, 1 };
+
+    CAPD_UTILS_CHECK(created.runs().size() != pushed.runs().size());
+    CAPD_UTILS_CHECK(created == pushed);
+    CAPD_UTILS_CHECK(!(created != pushed));
+
+    CAPD_UTILS_CHECK(IdxList<int>::create(7, 2, 3) == (IdxList<int>{ -1, -1, 0, 1, 2, -1, -1 }));
+    CAPD_UTILS_CHECK(IdxList<int>::create(7, 2, 3) != (IdxList<int>{ -1, -1, 0, 1, 2, -1 }));
+    CAPD_UTILS_CHECK(IdxList<int>::create(7, 2, 3) != (IdxList<int>{ -1, -1, 0, 1, 2, -1, 0 }));
+    CAPD_UTILS_CHECK(IdxList<int>() == IdxList<int>::create(0, 0, 0));
+}
+
+void test_out_of_range()
+{
+    const IdxList<int> list = IdxList<int>::create(4, 1, 2);
+
+    bool thrown = false;
+
+    try
+    {
+        list.at(4);
+    }
+    catch (const std::out_of_range&)
+    {
+        thrown = true;
+    }
+
+    CAPD_UTILS_CHECK(thrown);
+}
+
+}
+
+int main()
+{
+    CapdUtilsTests::run_test("create_range", test_create_range);
+    CapdUtilsTests::run_test("create_embedded", test_create_embedded);
+    CapdUtilsTests::run_test("push_back", test_push_back);
+    CapdUtilsTests::run_test("equality", test_equality);
+    CapdUtilsTests::run_test("out_of_range", test_out_of_range);
+
+    return CapdUtilsTests::report();
+}
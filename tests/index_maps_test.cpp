@@ -0,0 +1,400 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Author: Aleksander M. Pasiut
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//! @brief Index projection / extension maps and PNE accumulation compared with maps created by ProjectionMap::create and
+//!        ExtensionMap::create (see capd_utils/projection_map.hpp, capd_utils/extension_map.hpp, capd_utils/pne_map.hpp)
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <cstddef>
+#include <stdexcept>
+#include <vector>
+
+#include <capd_utils/block_sparse_matrix.hpp>
+#include <capd_utils/capd/basic_types.hpp>
+#include <capd_utils/capd/map.hpp>
+#include <capd_utils/extension_map.hpp>
+#include <capd_utils/identity_map.hpp>
+#include <capd_utils/map_base.hpp>
+#include <capd_utils/pne_map.hpp>
+#include <capd_utils/projection_map.hpp>
+
+#include "test_utils.hpp"
+
+namespace
+{
+
+using namespace CapdUtils;
+
+bool equal(const Interval& a, const Interval& b)
+{
+    return a.leftBound() == b.leftBound() && a.rightBound() == b.rightBound();
+}
+
+bool equal(const IVector& a, const IVector& b)
+{
+    if (a.dimension() != b.dimension())
+    {
+        return false;
+    }
+
+    for (unsigned i = 0; i < a.dimension(); ++i)
+    {
+        if (!equal(a[i], b[i]))
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+bool equal(const IMatrix& a, const IMatrix& b)
+{
+    if (a.numberOfRows() != b.numberOfRows() || a.numberOfColumns() != b.numberOfColumns())
+    {
+        return false;
+    }
+
+    for (unsigned i = 1; i <= a.numberOfRows(); ++i)
+    {
+        for (unsigned j = 1; j <= a.numberOfColumns(); ++j)
+        {
+            if (!equal(a(i, j), b(i, j)))
+            {
+                return false;
+            }
+        }
+    }
+
+    return true;
+}
+
+//! Vector of non-degenerate intervals depending on the seed
+IVector get_vector(unsigned dimension, int seed)
+{
+    IVector ret(dimension);
+    for (unsigned i = 0; i < dimension; ++i)
+    {
+        const double center = 0.25 * (seed + 3 * static_cast<int>(i)) - 1.0;
+        ret[i] = Interval(center - 0.125, center + 0.0625);
+    }
+
+    return ret;
+}
+
+IMatrix get_matrix(unsigned rows, unsigned cols, int seed)
+{
+    IMatrix ret(rows, cols);
+    for (unsigned i = 1; i <= rows; ++i)
+    {
+        const IVector row = get_vector(cols, seed + static_cast<int>(i));
+        for (unsigned j = 1; j <= cols; ++j)
+        {
+            ret(i, j) = row[j - 1];
+        }
+    }
+
+    return ret;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//! @brief Internal map x -> (x_0 x_1 + 1, x_1 x_2 + 2, ..., x_{m-1} x_m + m) (indices of x taken modulo n)
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+class ProductMap : public MapBase<IMap>
+{
+public:
+    ProductMap(unsigned n, unsigned m) : m_n(n), m_m(m)
+    {}
+
+    IVector operator() (const IVector& vec) override
+    {
+        IVector ret(m_m);
+        for (unsigned i = 0; i < m_m; ++i)
+        {
+            ret[i] = vec[i % m_n] * vec[(i + 1) % m_n] + Interval(i + 1.0);
+        }
+
+        return ret;
+    }
+
+    IVector operator() (const IVector& vec, IMatrix& mat) override
+    {
+        mat = IMatrix(m_m, m_n);
+        for (unsigned i = 0; i < m_m; ++i)
+        {
+            mat(i + 1, i % m_n + 1) += vec[(i + 1) % m_n];
+            mat(i + 1, (i + 1) % m_n + 1) += vec[i % m_n];
+        }
+
+        return (*this)(vec);
+    }
+
+    unsigned dimension() const noexcept override
+    {
+        return m_n;
+    }
+
+    unsigned imageDimension() const noexcept override
+    {
+        return m_m;
+    }
+
+private:
+    unsigned m_n;
+    unsigned m_m;
+};
+
+const std::vector<IdxList<int>>& get_extension_lists()
+{
+    static const std::vector<IdxList<int>> lists
+    {
+        IdxList<int>{ -1, 1, 0, -1, -1 },
+        IdxList<int>{ -1, 0, 1, 2, -1 },            // mixed run (-1, 0, 1, 2)
+        IdxList<int>{ -2, -1, 0, 1, 1, 1, -1, 3 },  // mixed run (-2, -1, 0, 1) followed by fills
+        IdxList<int>{ 2, 2, 0, 1, 2 },
+        IdxList<int>::create(7, 2, 3),
+        IdxList<int>::create(3, 0, 3)
+    };
+
+    return lists;
+}
+
+void test_projection_map()
+{
+    const size_t input_size = 6;
+
+    const std::vector<IdxList<size_t>> lists
+    {
+        IdxList<size_t>{ 2, 1 },
+        IdxList<size_t>{ 3, 3, 3, 0, 1, 2, 5 },
+        IdxList<size_t>{ 5 },
+        IdxList<size_t>::create(1, 4)
+    };
+
+    for (const IdxList<size_t>& list : lists)
+    {
+        IMap reference = ProjectionMap<IMap>::create(input_size, list);
+        IndexProjectionMap<IMap> map(input_size, list);
+
+        CAPD_UTILS_CHECK(map.dimension() == reference.dimension());
+        CAPD_UTILS_CHECK(map.imageDimension() == reference.imageDimension());
+        CAPD_UTILS_CHECK(map.indices() == list);
+
+        const IVector x = get_vector(input_size, 1);
+
+        IMatrix der(map.imageDimension(), map.dimension());
+        IMatrix reference_der(map.imageDimension(), map.dimension());
+        CAPD_UTILS_CHECK(equal(map(x), reference(x)));
+        CAPD_UTILS_CHECK(equal(map(x, der), reference(x, reference_der)));
+        CAPD_UTILS_CHECK(equal(der, reference_der));
+    }
+
+    bool thrown = false;
+
+    try
+    {
+        IndexProjectionMap<IMap>(input_size, IdxList<size_t>{ 0, 6 });
+    }
+    catch (const std::logic_error&)
+    {
+        thrown = true;
+    }
+
+    CAPD_UTILS_CHECK(thrown);
+}
+
+void test_extension_map()
+{
+    for (const IdxList<int>& list : get_extension_lists())
+    {
+        const IVector values = get_vector(list.size(), 5);
+
+        IMap reference = ExtensionMap<IMap>::create(values, list);
+        IndexExtensionMap<IMap> map(values, list);
+
+        CAPD_UTILS_CHECK(map.dimension() == reference.dimension());
+        CAPD_UTILS_CHECK(map.imageDimension() == reference.imageDimension());
+        CAPD_UTILS_CHECK(map.indices() == list);
+
+        const IVector x = get_vector(map.dimension(), 2);
+
+        IMatrix der(map.imageDimension(), map.dimension());
+        IMatrix reference_der(map.imageDimension(), map.dimension());
+        CAPD_UTILS_CHECK(equal(map(x), reference(x)));
+        CAPD_UTILS_CHECK(equal(map(x, der), reference(x, reference_der)));
+        CAPD_UTILS_CHECK(equal(der, reference_der));
+
+        // extension values are changed, outputs taken from the input are not affected
+        for (unsigned i = 0; i < list.size(); ++i)
+        {
+            map.setParameter(i, Interval(-10.0 - i));
+            reference.setParameter(i, Interval(-10.0 - i));
+        }
+
+        CAPD_UTILS_CHECK(equal(map(x), reference(x)));
+    }
+}
+
+void test_zero_extension_map()
+{
+    for (const IdxList<int>& list : get_extension_lists())
+    {
+        IMap reference = ExtensionMap<IMap>::create(list);
+        IndexExtensionMap<IMap> map(list);
+
+        CAPD_UTILS_CHECK(map.dimension() == reference.dimension());
+        CAPD_UTILS_CHECK(map.imageDimension() == reference.imageDimension());
+
+        const IVector x = get_vector(map.dimension(), 3);
+
+        IMatrix der(map.imageDimension(), map.dimension());
+        IMatrix reference_der(map.imageDimension(), map.dimension());
+        CAPD_UTILS_CHECK(equal(map(x), reference(x)));
+        CAPD_UTILS_CHECK(equal(map(x, der), reference(x, reference_der)));
+        CAPD_UTILS_CHECK(equal(der, reference_der));
+
+        // the first parameter allocates extension values (the rest stays zero)
+        IMap reference_values = ExtensionMap<IMap>::create(IVector(list.size()), list);
+        map.setParameter(0, Interval(7.0));
+        reference_values.setParameter(0, Interval(7.0));
+
+        CAPD_UTILS_CHECK(equal(map(x), reference_values(x)));
+    }
+}
+
+void test_pne_accumulate()
+{
+    struct Case
+    {
+        IdxList<size_t> in;
+        IdxList<int> out;
+    };
+
+    const size_t input_size = 7;
+
+    const std::vector<Case> cases
+    {
+        { IdxList<size_t>{ 4, 0, 2 }, IdxList<int>{ -1, 2, -1, 0, 1 } },
+        { IdxList<size_t>{ 6, 5 }, IdxList<int>{ -1, 0, 1, -1, 1, 1 } },
+        { IdxList<size_t>::create(2, 3), IdxList<int>::create(6, 2, 2) },
+        { IdxList<size_t>::create(0, 3), IdxList<int>{ 2, -1, 0, 1, 0 } }
+    };
+
+    for (const Case& c : cases)
+    {
+        const unsigned n = c.in.size();
+        const unsigned m = IndexExtensionMap<IMap>(c.out).dimension();
+
+        IMap projection = ProjectionMap<IMap>::create(input_size, c.in);
+        IMap extension = ExtensionMap<IMap>::create(c.out);
+        ProductMap internal(n, m);
+
+        PNE<IMap, ProductMap> pne(input_size, c.in, c.out, n, m);
+
+        const IVector x = get_vector(input_size, 4);
+
+        IMatrix d1(n, input_size), d2(m, n), d3(c.out.size(), m);
+        const IVector reference = extension(internal(projection(x, d1), d2), d3);
+        const IMatrix reference_der = d3 * d2 * d1;
+
+        for (int sign : { 1, -1 })
+        {
+            IVector value = get_vector(c.out.size(), 6);
+            IMatrix der = get_matrix(c.out.size(), input_size, 8);
+
+            const IVector expected_value = sign > 0 ? value + reference : value - reference;
+            const IMatrix expected_der = sign > 0 ? der + reference_der : der - reference_der;
+
+            pne.accumulate(x, value, der, sign);
+
+            CAPD_UTILS_CHECK(equal(value, expected_value));
+            CAPD_UTILS_CHECK(equal(der, expected_der));
+        }
+
+        IMatrix der(c.out.size(), input_size);
+        CAPD_UTILS_CHECK(equal(pne(x, der), reference));
+        CAPD_UTILS_CHECK(equal(der, reference_der));
+    }
+}
+
+void test_pne_accumulate_identity()
+{
+    const size_t input_size = 5;
+    const IdxList<size_t> in { 3, 1 };
+    const IdxList<int> out { 1, -1, 0, 0 };
+
+    IMap projection = ProjectionMap<IMap>::create(input_size, in);
+    IMap extension = ExtensionMap<IMap>::create(out);
+
+    PNE<IMap, IdentityMap<IMap>> pne(input_size, in, out, in.size());
+
+    const IVector x = get_vector(input_size, 9);
+
+    IMatrix d1(in.size(), input_size), d2(out.size(), in.size());
+    const IVector reference = extension(projection(x, d1), d2);
+
+    IVector value = get_vector(out.size(), 1);
+    IMatrix der = get_matrix(out.size(), input_size, 2);
+
+    const IVector expected_value = value - reference;
+    const IMatrix expected_der = der - d2 * d1;
+
+    pne.accumulate(x, value, der, -1);
+
+    CAPD_UTILS_CHECK(equal(value, expected_value));
+    CAPD_UTILS_CHECK(equal(der, expected_der));
+}
+
+void test_pne_accumulate_sparse()
+{
+    const size_t input_size = 7;
+    const IdxList<size_t> in = IdxList<size_t>::create(2, 3);
+    const IdxList<int> out = IdxList<int>::create(6, 2, 2);
+
+    PNE<IMap, ProductMap> pne(input_size, in, out, 3u, 2u);
+
+    const IVector x = get_vector(input_size, 4);
+
+    IVector dense_value = get_vector(out.size(), 6);
+    IVector sparse_value = dense_value;
+    IMatrix dense_der(out.size(), input_size);
+    BlockSparseMatrix<IMap> sparse_der(out.size(), input_size);
+
+    pne.accumulate(x, dense_value, dense_der, -1);
+    pne.accumulate(x, sparse_value, sparse_der, -1);
+
+    CAPD_UTILS_CHECK(equal(sparse_value, dense_value));
+    CAPD_UTILS_CHECK(equal(sparse_der.to_dense(), dense_der));
+
+    // extension list with input indices out of order has no single block
+    PNE<IMap, ProductMap> shuffled(input_size, in, IdxList<int>{ -1, 1, 0, -1, -1, -1 }, 3u, 2u);
+
+    bool thrown = false;
+
+    try
+    {
+        shuffled.accumulate(x, sparse_value, sparse_der, 1);
+    }
+    catch (const std::logic_error&)
+    {
+        thrown = true;
+    }
+
+    CAPD_UTILS_CHECK(thrown);
+}
+
+}
+
+int main()
+{
+    CapdUtilsTests::run_test("projection_map", test_projection_map);
+    CapdUtilsTests::run_test("extension_map", test_extension_map);
+    CapdUtilsTests::run_test("zero_extension_map", test_zero_extension_map);
+    CapdUtilsTests::run_test("pne_accumulate", test_pne_accumulate);
+    CapdUtilsTests::run_test("pne_accumulate_identity", test_pne_accumulate_identity);
+    CapdUtilsTests::run_test("pne_accumulate_sparse", test_pne_accumulate_sparse);
+
+    return CapdUtilsTests::report();
+}
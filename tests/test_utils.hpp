@@ -0,0 +1,56 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Author: Aleksander M. Pasiut
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <cstdio>
+#include <exception>
+
+namespace CapdUtilsTests
+{
+
+inline int& failures()
+{
+    static int count = 0;
+    return count;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//! @brief Run test function, report exceptions as failures
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+template<typename FuncT>
+void run_test(const char* name, FuncT func)
+{
+    const int failures_before = failures();
+
+    try
+    {
+        func();
+    }
+    catch (const std::exception& e)
+    {
+        std::printf("%s: unexpected exception: %s\n", name, e.what());
+        ++failures();
+    }
+
+    std::printf("[%s] %s\n", failures() == failures_before ? "  OK  " : "FAILED", name);
+}
+
+inline int report()
+{
+    std::printf("%d failure(s)\n", failures());
+    return failures() == 0 ? 0 : 1;
+}
+
+}
+
+#define CAPD_UTILS_CHECK(condition) \
+    do \
+    { \
+        if (!(condition)) \
+        { \
+            std::printf("%s:%d: check failed: %s\n", __FILE__, __LINE__, #condition); \
+            ++CapdUtilsTests::failures(); \
+        } \
+    } while (false)
@@ -0,0 +1,122 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Author: Aleksander M. Pasiut
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//! @brief Nested and concurrent batches of ThreadPool / ParallelExecution (see capd_utils/thread_pool.hpp)
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <atomic>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include <capd_utils/execution_policy.hpp>
+
+#include "test_utils.hpp"
+
+namespace
+{
+
+using namespace CapdUtils;
+
+void test_batch()
+{
+    std::vector<int> results(100, 0);
+
+    ParallelExecution(4).run(results.size(), [&](size_t i) { results[i] = static_cast<int>(i) * 2; });
+
+    for (size_t i = 0; i < results.size(); ++i)
+    {
+        CAPD_UTILS_CHECK(results[i] == static_cast<int>(i) * 2);
+    }
+}
+
+void test_nested_batch()
+{
+    const size_t outer = 8;
+    const size_t inner = 16;
+
+    ParallelExecution policy(4);
+    std::atomic<size_t> count { 0 };
+
+    // copies of the policy share the pool, the inner batches are submitted by its tasks
+    policy.run(outer, [&, policy](size_t) mutable
+    {
+        policy.run(inner, [&](size_t) { ++count; });
+    });
+
+    CAPD_UTILS_CHECK(count == outer * inner);
+}
+
+void test_concurrent_batches()
+{
+    ParallelExecution policy(4);
+    std::atomic<size_t> count { 0 };
+
+    std::vector<std::thread> threads {};
+    for (unsigned t = 0; t < 4; ++t)
+    {
+        threads.emplace_back([&, policy]() mutable
+        {
+            for (int k = 0; k < 50; ++k)
+            {
+                policy.run(10, [&](size_t) { ++count; });
+            }
+        });
+    }
+
+    for (std::thread& thread : threads)
+    {
+        thread.join();
+    }
+
+    CAPD_UTILS_CHECK(count == 4 * 50 * 10);
+}
+
+void test_exception()
+{
+    bool thrown = false;
+
+    try
+    {
+        ParallelExecution(4).run(10, [](size_t i)
+        {
+            if (i == 7)
+            {
+                throw std::runtime_error("task failed");
+            }
+        });
+    }
+    catch (const std::runtime_error&)
+    {
+        thrown = true;
+    }
+
+    CAPD_UTILS_CHECK(thrown);
+}
+
+void test_default_pool()
+{
+    std::atomic<size_t> count { 0 };
+
+    for (int k = 0; k < 100; ++k)
+    {
+        ParallelExecution().run(10, [&](size_t) { ++count; });
+    }
+
+    CAPD_UTILS_CHECK(count == 100 * 10);
+}
+
+}
+
+int main()
+{
+    CapdUtilsTests::run_test("batch", test_batch);
+    CapdUtilsTests::run_test("nested_batch", test_nested_batch);
+    CapdUtilsTests::run_test("concurrent_batches", test_concurrent_batches);
+    CapdUtilsTests::run_test("exception", test_exception);
+    CapdUtilsTests::run_test("default_pool", test_default_pool);
+
+    return CapdUtilsTests::report();
+}